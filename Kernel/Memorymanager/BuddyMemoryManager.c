@@ -1,225 +1,245 @@
 #ifdef BUDDY
 #include <memoryManager.h>
 #include <defs.h>
+#include <lib.h>
 #include <stdint.h>
 #include <stddef.h>
 
-#define MIN_ORDER 6 // Minimum block size will be 2^6 = 64 bytes, matching BLOCK_SIZE
-#define MAX_ORDER 30 // A sufficiently large max order
+#define MIN_ORDER 6  // Minimum block size will be 2^6 = 64 bytes, matching BLOCK_SIZE
+#define MAX_ORDER 30 // Largest block 2^30 = 1 GiB, above the 512 MiB the heap ends at (HEAP_END_ADDRESS)
 
-enum { FREE, OCCUPIED };
+/*
+ * Block state lives out of band: one byte per 2^MIN_ORDER unit of the heap,
+ * meaningful only at the unit where a block starts. Allocated blocks carry
+ * no header, so payloads are naturally aligned to their block size.
+ */
+#define STATE_FREE 0x80
+#define STATE_ALLOCATED 0x40
+#define STATE_ORDER_MASK 0x3F
 
+/* Free blocks keep their list links inside the (unused) block itself */
 typedef struct block_t {
-  int8_t order;
-  int8_t status;
-  struct block_t *next;
+	struct block_t *next;
+	struct block_t *prev;
 } block_t;
 
 typedef struct buddy_manager {
-  int8_t max_order;
-  block_t *free_blocks[MAX_ORDER];
-  uint64_t total_mem;
-  uint64_t used_mem;
+	uintptr_t first_block; /* first byte handed out as a block, described by state[0] */
+	uintptr_t end;         /* one past the last managed byte */
+	uint8_t *state;        /* per-unit order/state map */
+	block_t *free_blocks[MAX_ORDER + 1];
+	uint64_t non_empty;    /* bit i set if free_blocks[i] is not empty */
+	uint64_t total_mem;
+	uint64_t used_mem;
 } buddy_manager;
 
 static buddy_manager buddy_man;
 
 // --- Forward declarations for helper functions ---
-static block_t *create_block(void *address, int8_t order);
-static void remove_block(block_t *block);
-static void split_block(int8_t order);
+static uint8_t *state_of(uintptr_t address);
+static void push_block(uintptr_t address, int8_t order);
+static void unlink_block(block_t *block, int8_t order);
+static block_t *pop_block(int8_t order);
+static int8_t size_to_order(uint64_t size);
 
 
 // --- Core Implementation ---
 
 /*
- * create_block
- * @param address: memory address where the block header will be placed
- * @param order:  exponent representing block size (size = 2^order)
- * @return: pointer to the created block header
- *
- * Inserts a new free block header at `address` into the free list for
- * the given `order`.
+ * state_of
+ * @param address: address of the first byte of a block
+ * @return: pointer to the state byte describing the block at `address`
  */
-static block_t *create_block(void *address, int8_t order) {
-  block_t *block = (block_t *)address;
-  block->order = order;
-  block->status = FREE;
-  block->next = buddy_man.free_blocks[order];
-  buddy_man.free_blocks[order] = block;
-  return block;
+static uint8_t *state_of(uintptr_t address)
+{
+	return &buddy_man.state[(address - buddy_man.first_block) >> MIN_ORDER];
 }
 
 /*
- * remove_block
- * @param block: pointer to a block header that should be removed from its
- *               free-list
+ * push_block
+ * @param address: address of a free block
+ * @param order:   exponent representing block size (size = 2^order)
  *
- * Removes `block` from the free-list of its order and marks it as OCCUPIED.
- * If the block is not present or lists are empty the function silently
- * returns.
+ * Marks the block as free and inserts it at the head of the free list
+ * for `order`.
  */
-static void remove_block(block_t *block) {
-  if (block == NULL) {
-    return;
-  }
-  uint8_t order = block->order;
-  block_t *curr_block = buddy_man.free_blocks[order];
-  if (curr_block == NULL) {
-    return;
-  }
-
-  if (curr_block == block) {
-    buddy_man.free_blocks[order]->status = OCCUPIED;
-    buddy_man.free_blocks[order] = buddy_man.free_blocks[order]->next;
-    return;
-  }
-
-  while (curr_block->next != NULL && curr_block->next != block) {
-    curr_block = curr_block->next;
-  }
-
-  if (curr_block->next == NULL) {
-    return;
-  }
-
-  curr_block->next = curr_block->next->next;
-  block->status = OCCUPIED; /* mark removed block as occupied */
+static void push_block(uintptr_t address, int8_t order)
+{
+	block_t *block = (block_t *)address;
+	block->prev = NULL;
+	block->next = buddy_man.free_blocks[order];
+	if (block->next != NULL) {
+		block->next->prev = block;
+	}
+	buddy_man.free_blocks[order] = block;
+	buddy_man.non_empty |= (1UL << order);
+	*state_of(address) = STATE_FREE | order;
 }
 
 /*
- * split_block
- * @param order: order index of a block to split into two blocks of order-1
+ * unlink_block
+ * @param block: free block currently linked in the list of `order`
+ * @param order: order of the block
  *
- * Removes one free block of `order` from its list, splits it into two
- * blocks of `order-1` and inserts the two halves back into that lower
- * order free-list.
+ * Removes `block` from its free list in O(1). The caller updates the
+ * state byte.
  */
-static void split_block(int8_t order) {
-  block_t *block = buddy_man.free_blocks[order];
-  remove_block(block);
-  block_t *buddy_block = (block_t *)((void *)block + (1L << (order - 1)));
-  create_block((void *)buddy_block, order - 1);
-  create_block((void *)block, order - 1);
+static void unlink_block(block_t *block, int8_t order)
+{
+	if (block->prev != NULL) {
+		block->prev->next = block->next;
+	} else {
+		buddy_man.free_blocks[order] = block->next;
+	}
+	if (block->next != NULL) {
+		block->next->prev = block->prev;
+	}
+	if (buddy_man.free_blocks[order] == NULL) {
+		buddy_man.non_empty &= ~(1UL << order);
+	}
 }
 
-void createMemoryManager(void *start, uint64_t size) {
-    uint64_t total_size = size;
-    int8_t order = 0;
-    uint64_t current_size = 1;
-    while(current_size < total_size) {
-        current_size *= 2;
-        order++;
-    }
-    
-    buddy_man.max_order = order;
-    buddy_man.total_mem = current_size;
-    buddy_man.used_mem = 0;
-
-    for (int i = 0; i < MAX_ORDER; i++) {
-        buddy_man.free_blocks[i] = NULL;
-    }
-    create_block(start, order);
+/*
+ * pop_block
+ * @param order: order of a non-empty free list
+ * @return: the first block of that list, already unlinked
+ */
+static block_t *pop_block(int8_t order)
+{
+	block_t *block = buddy_man.free_blocks[order];
+	unlink_block(block, order);
+	return block;
 }
 
-void *allocMemory(const size_t memoryToAllocate) {
-    if (memoryToAllocate <= 0 || memoryToAllocate > HEAP_SIZE) {
-        return NULL;
-    }
-
-  /*
-   * Compute the required order (power-of-two) that can contain the
-   * requested payload + block header.
-   */
-  int8_t order = 1;
-  int64_t block_size = 2;
-  while (block_size < memoryToAllocate + sizeof(block_t)) {
-    order++;
-    block_size *= 2;
-  }
-
-    order = (MIN_ORDER > order) ? MIN_ORDER : order;
-
-  /*
-   * If there's no free block at that order, search for a larger block and
-   * split it down until we obtain one of the desired order.
-   */
-  if (buddy_man.free_blocks[order] == NULL) {
-    uint8_t order_approx = 0;
-    for (uint8_t i = order + 1; i <= buddy_man.max_order && order_approx == 0; i++) {
-      if (buddy_man.free_blocks[i] != NULL) {
-        order_approx = i;
-      }
-    }
-
-        if (order_approx == 0) {
-            return NULL; // No suitable block found
-        }
-
-    while (order_approx > order) {
-      split_block(order_approx);
-      order_approx--;
-    }
-  }
-
-  /* allocate from the chosen free-list */
-  block_t *block = buddy_man.free_blocks[order];
-  remove_block(block);
-  block->status = OCCUPIED;
-  buddy_man.used_mem += (1L << order);
-
-    return (void *)((uint8_t *)block + sizeof(block_t));
+/*
+ * size_to_order
+ * @param size: requested size in bytes (> 0)
+ * @return: smallest order whose block holds `size` bytes
+ */
+static int8_t size_to_order(uint64_t size)
+{
+	if (size <= (1UL << MIN_ORDER)) {
+		return MIN_ORDER;
+	}
+	return 64 - __builtin_clzl(size - 1);
 }
 
-void freeMemory(void *address) {
-  if (address == NULL) {
-    return;
-  }
-
-  /* locate the block header from the user pointer */
-  block_t *block = (block_t *)((uint8_t *)address - sizeof(block_t));
-  if (block->status == FREE) {
-    return;
-  }
-
-  buddy_man.used_mem -= (1L << block->order);
-  block->status = FREE;
+void createMemoryManager(void *start, uint64_t size)
+{
+	uint64_t unit = 1UL << MIN_ORDER;
+	uintptr_t end = ((uintptr_t)start + size) & ~(unit - 1);
+
+	/*
+	 * The state map sits at the start of the heap and only describes the
+	 * units after it: m bytes cover size - m bytes when m >= size / (unit + 1).
+	 */
+	uint64_t state_bytes = (size + unit) / (unit + 1);
+	uintptr_t first_block = ((uintptr_t)start + state_bytes + unit - 1) & ~(unit - 1);
+
+	buddy_man.first_block = first_block;
+	buddy_man.end = end;
+	buddy_man.state = (uint8_t *)start;
+	buddy_man.used_mem = 0;
+	buddy_man.total_mem = end - first_block;
+	buddy_man.non_empty = 0;
+
+	for (int i = 0; i <= MAX_ORDER; i++) {
+		buddy_man.free_blocks[i] = NULL;
+	}
+	memset(buddy_man.state, 0, state_bytes);
+
+	/*
+	 * Seed the region with maximal aligned power-of-two blocks: at each
+	 * address take the largest block that is aligned there and still ends
+	 * inside the heap. The seeds cover [first_block, end) exactly, and no
+	 * two of them are buddies, so merging never crosses the heap bounds.
+	 */
+	uintptr_t address = first_block;
+	while (address < end) {
+		int8_t order = __builtin_ctzl(address);
+		int8_t fits = 63 - __builtin_clzl(end - address);
+		if (order > fits) {
+			order = fits;
+		}
+		if (order > MAX_ORDER) {
+			order = MAX_ORDER;
+		}
+		push_block(address, order);
+		address += 1UL << order;
+	}
+}
 
-  /*
-   * Try to merge free buddies iteratively: compute the buddy position using
-   * XOR and, if the buddy is free and of same order, remove both and form
-   * a single block at order+1.
-   */
-  uint64_t block_pos = (uint64_t)((void *)block - HEAP_START_ADDRESS);
+void *allocMemory(const size_t memoryToAllocate)
+{
+	if (memoryToAllocate == 0 || memoryToAllocate > (1UL << MAX_ORDER)) {
+		return NULL;
+	}
 
-  while (block->order < buddy_man.max_order) {
-    uint64_t buddy_pos = block_pos ^ (1L << block->order);
-    block_t *buddy_block = (block_t *)((uint64_t)HEAP_START_ADDRESS + buddy_pos);
+	int8_t order = size_to_order(memoryToAllocate);
 
-    if (buddy_block->status != FREE || buddy_block->order != block->order) {
-      break; /* buddy not mergeable */
-    }
+	/* smallest non-empty free list that can hold the request */
+	uint64_t candidates = buddy_man.non_empty & ~((1UL << order) - 1);
+	if (candidates == 0) {
+		return NULL; // No suitable block found
+	}
+	int8_t current = __builtin_ctzl(candidates);
+	uintptr_t block = (uintptr_t)pop_block(current);
 
-    block_t *left_block = (block_pos < buddy_pos) ? block : buddy_block;
+	/* split down, returning the upper halves to their free lists */
+	while (current > order) {
+		current--;
+		push_block(block + (1UL << current), current);
+	}
 
-    remove_block(block);
-    remove_block(buddy_block);
+	*state_of(block) = STATE_ALLOCATED | order;
+	buddy_man.used_mem += (1UL << order);
 
-    left_block->order++;
-    block = left_block;
-    block_pos = (uint64_t)((void *)block - HEAP_START_ADDRESS);
-  }
+	return (void *)block;
+}
 
-  create_block((void *)block, block->order);
+void freeMemory(void *address)
+{
+	uintptr_t block = (uintptr_t)address;
+	if (block < buddy_man.first_block || block >= buddy_man.end ||
+	    (block & ((1UL << MIN_ORDER) - 1)) != 0) {
+		return;
+	}
+
+	uint8_t state = *state_of(block);
+	if (!(state & STATE_ALLOCATED)) {
+		return; /* not the start of a live allocation */
+	}
+	int8_t order = state & STATE_ORDER_MASK;
+	buddy_man.used_mem -= (1UL << order);
+
+	/*
+	 * Merge with the buddy while it is a free block of the same order. The
+	 * buddy of a naturally aligned block is found by flipping the size bit.
+	 */
+	while (order < MAX_ORDER) {
+		uintptr_t buddy = block ^ (1UL << order);
+		if (buddy < buddy_man.first_block || buddy >= buddy_man.end ||
+		    *state_of(buddy) != (STATE_FREE | order)) {
+			break; /* buddy not mergeable */
+		}
+		unlink_block((block_t *)buddy, order);
+		/* the upper half stops being a block start */
+		*state_of(block > buddy ? block : buddy) = 0;
+		block = block < buddy ? block : buddy;
+		order++;
+	}
+
+	push_block(block, order);
 }
 
-void getMemoryInfo(memInfo *info) {
-    if (info == NULL) {
-        return;
-    }
-    info->total = buddy_man.total_mem;
-    info->used = buddy_man.used_mem;
-    info->free = info->total - info->used;
+void getMemoryInfo(memInfo *info)
+{
+	if (info == NULL) {
+		return;
+	}
+	info->total = buddy_man.total_mem;
+	info->used = buddy_man.used_mem;
+	info->free = info->total - info->used;
 }
 
 #endif
\ No newline at end of file
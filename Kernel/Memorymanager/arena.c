@@ -0,0 +1,120 @@
+#include <arena.h>
+#include <memoryManager.h>
+#include <slab.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARENA_BUCKETS_LOG2 8 /* the address -> block table has 2^8 buckets */
+
+/*
+ * Bookkeeping lives out of band, in slab objects: blocks are handed out
+ * exactly as the memory manager returns them, so a power-of-two request
+ * stays in its buddy order and keeps the block's natural alignment.
+ */
+typedef struct arenaBlock {
+	ListNode node;               /* link in the owner's arena */
+	struct arenaBlock *hashNext; /* next block in the same bucket */
+	PCB *owner;
+	void *address;
+	uint64_t size;
+} arenaBlock;
+
+static kmem_cache_t *blockCache = NULL;
+static arenaBlock *buckets[1 << ARENA_BUCKETS_LOG2];
+
+/*
+ * bucketOf
+ * @param address: block address returned by the memory manager
+ * @return: head of the bucket holding `address`
+ */
+static arenaBlock **bucketOf(void *address)
+{
+	/* blocks are aligned to their size: mix the high bits down (Fibonacci hashing) */
+	uint64_t hash = ((uintptr_t)address >> 4) * 0x9E3779B97F4A7C15UL;
+	return &buckets[hash >> (64 - ARENA_BUCKETS_LOG2)];
+}
+
+/*
+ * unlinkBlock
+ * Removes `block` from its owner's arena and from the address table.
+ * @param slot: bucket link that points at `block`
+ * @param block: block to unlink
+ */
+static void unlinkBlock(arenaBlock **slot, arenaBlock *block)
+{
+	*slot = block->hashNext;
+	block->node.prev->next = block->node.next;
+	block->node.next->prev = block->node.prev;
+	block->owner->memoryUsed -= block->size;
+}
+
+void initArena(PCB *owner)
+{
+	owner->arena.next = &owner->arena;
+	owner->arena.prev = &owner->arena;
+	owner->memoryUsed = 0;
+}
+
+void *arenaAlloc(PCB *owner, uint64_t size)
+{
+	if (owner == NULL || size == 0) {
+		return NULL;
+	}
+	if (blockCache == NULL && (blockCache = kmem_cache_create("arena", sizeof(arenaBlock))) == NULL) {
+		return NULL;
+	}
+	arenaBlock *block = kmem_cache_alloc(blockCache);
+	if (block == NULL) {
+		return NULL;
+	}
+	block->address = allocMemory(size);
+	if (block->address == NULL) {
+		kmem_cache_free(blockCache, block);
+		return NULL;
+	}
+	block->owner = owner;
+	block->size = size;
+	arenaBlock **bucket = bucketOf(block->address);
+	block->hashNext = *bucket;
+	*bucket = block;
+	block->node.prev = &owner->arena;
+	block->node.next = owner->arena.next;
+	owner->arena.next->prev = &block->node;
+	owner->arena.next = &block->node;
+	owner->memoryUsed += size;
+	return block->address;
+}
+
+void arenaFree(void *address)
+{
+	if (address == NULL) {
+		return;
+	}
+	for (arenaBlock **slot = bucketOf(address); *slot != NULL; slot = &(*slot)->hashNext) {
+		arenaBlock *block = *slot;
+		if (block->address == address) {
+			unlinkBlock(slot, block);
+			freeMemory(address);
+			kmem_cache_free(blockCache, block);
+			return;
+		}
+	}
+}
+
+void releaseArena(PCB *owner)
+{
+	ListNode *node = owner->arena.next;
+	while (node != &owner->arena) {
+		ListNode *next = node->next;
+		arenaBlock *block = (arenaBlock *)node;
+		arenaBlock **slot = bucketOf(block->address);
+		while (*slot != block) {
+			slot = &(*slot)->hashNext;
+		}
+		unlinkBlock(slot, block);
+		freeMemory(block->address);
+		kmem_cache_free(blockCache, block);
+		node = next;
+	}
+	initArena(owner);
+}
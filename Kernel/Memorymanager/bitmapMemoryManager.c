@@ -1,24 +1,68 @@
-#ifndef BUDDY
+#if !defined(BUDDY) && !defined(TLSF)
 #include "../../Shared/shared_structs.h"
 #include "memoryManager.h"
-#include <defs.h>
+#include <lib.h>
 #include <stdint.h>
 
-enum { FREE, USED, START_BOUNDARY, END_BOUNDARY, SINGLE_BLOCK };
+#define BITS_PER_WORD 64
+#define ALL_ONES (~0UL)
+#define WORDS_PER_LEAF 4
+#define BLOCKS_PER_LEAF (WORDS_PER_LEAF * BITS_PER_WORD)
+
+/* Fit policy, selectable at build time with -DBITMAP_FIT=BEST_FIT */
+#define FIRST_FIT 0
+#define BEST_FIT 1
+#ifndef BITMAP_FIT
+#define BITMAP_FIT FIRST_FIT
+#endif
+
+/*
+ * Block state is packed in two bit planes with one bit per BLOCK_SIZE block:
+ * - bitmap:     1 if the block is in use
+ * - boundaries: 1 if the block is the last block of an allocation
+ * An allocation starts at a used block whose predecessor is free or ends
+ * another allocation.
+ *
+ * A segment tree summarizes the used plane: each leaf covers
+ * BLOCKS_PER_LEAF blocks and every node stores the free run touching its
+ * left edge, the one touching its right edge and the longest free run
+ * inside it. It also keeps one bit per power-of-two size class of the
+ * free runs lying strictly inside the node, away from both edges, so
+ * BEST_FIT can pick the smallest class that fits like a segregated-fit
+ * allocator. Updates and searches walk one root-to-leaf path.
+ */
+typedef struct runSummary {
+	uint32_t prefix;
+	uint32_t suffix;
+	uint32_t longest;
+	uint32_t classes; /* bit k set: an inner run of [2^k, 2^(k + 1)) blocks */
+} runSummary;
 
 typedef struct MemoryManagerCDT {
 	void *start;
 	uint32_t blockQty;
 	uint32_t blocksUsed;
-	uint32_t *bitmap;
-	uint32_t current;
+	uint32_t wordQty;
+	uint64_t *bitmap;
+	uint64_t *boundaries;
+	runSummary *tree;   /* implicit tree, root at 1, leaves at leafBase */
+	uint32_t leafBase;  /* number of leaves, a power of two */
+	uint32_t leafShift; /* log2(leafBase) */
 } MemoryManagerCDT;
 
 static MemoryManagerCDT memoryManager;
 
-static uint32_t sizeToBlockQty(uint32_t size);
-static void *markGroupAsUsed(uint32_t blocksNeeded, uint32_t index);
-static uintptr_t findFreeBlocks(uint32_t blocksNeeded, uint32_t start, uint32_t end);
+static uint64_t sizeToBlockQty(uint64_t size);
+static void setBits(uint64_t *plane, uint32_t index, uint32_t count, int value);
+static int testBit(uint64_t *plane, uint32_t index);
+static int nextFreeRun(uint32_t from, uint32_t to, uint32_t *runStart, uint32_t *runLength);
+static void summarizeLeaf(uint32_t leaf);
+static void combine(uint32_t node);
+static void updateTree(uint32_t index, uint32_t count);
+static uint32_t classOf(uint32_t length);
+static int64_t findInLeaf(uint32_t leaf, uint32_t blocksNeeded, uint32_t fitClass);
+static int64_t findBestFit(uint32_t blocksNeeded);
+static int64_t findFreeBlocks(uint32_t blocksNeeded);
 static void initializeBitmap();
 
 /*
@@ -26,123 +70,381 @@ static void initializeBitmap();
  * @param size: requested size in bytes
  * @return: number of BLOCK_SIZE blocks required to satisfy `size`
  */
-static uint32_t sizeToBlockQty(uint32_t size)
+static uint64_t sizeToBlockQty(uint64_t size)
+{
+	return (size % BLOCK_SIZE) ? (size / BLOCK_SIZE) + 1 : size / BLOCK_SIZE;
+}
+
+/*
+ * testBit
+ * @return: value of bit `index` in `plane`
+ */
+static int testBit(uint64_t *plane, uint32_t index)
+{
+	return (plane[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1;
+}
+
+/*
+ * setBits
+ * Sets (value != 0) or clears `count` consecutive bits of `plane` starting
+ * at `index`, a whole word at a time wherever possible.
+ */
+static void setBits(uint64_t *plane, uint32_t index, uint32_t count, int value)
 {
-	return (uint32_t)((size % BLOCK_SIZE) ? (size / BLOCK_SIZE) + 1 : size / BLOCK_SIZE);
+	while (count > 0) {
+		uint32_t word = index / BITS_PER_WORD;
+		uint32_t offset = index % BITS_PER_WORD;
+		uint32_t bits = BITS_PER_WORD - offset;
+		if (bits > count) {
+			bits = count;
+		}
+		uint64_t mask = (bits == BITS_PER_WORD) ? ALL_ONES : ((1UL << bits) - 1) << offset;
+		if (value) {
+			plane[word] |= mask;
+		} else {
+			plane[word] &= ~mask;
+		}
+		index += bits;
+		count -= bits;
+	}
 }
 
 /*
  * initializeBitmap
- * Marks all entries in the bitmap as FREE.
+ * Marks every block as free and builds the tree. Bits past the last block
+ * of the final word are marked as used so they never appear as free.
  */
 static void initializeBitmap()
 {
-	/* mark each block as FREE */
-	for (uint32_t i = 0; i < memoryManager.blockQty; i++) {
-		memoryManager.bitmap[i] = FREE;
+	memset(memoryManager.bitmap, 0, memoryManager.wordQty * sizeof(uint64_t));
+	memset(memoryManager.boundaries, 0, memoryManager.wordQty * sizeof(uint64_t));
+	uint32_t padding = memoryManager.wordQty * BITS_PER_WORD - memoryManager.blockQty;
+	setBits(memoryManager.bitmap, memoryManager.blockQty, padding, 1);
+
+	for (uint32_t leaf = 0; leaf < memoryManager.leafBase; leaf++) {
+		summarizeLeaf(leaf);
+	}
+	for (uint32_t node = memoryManager.leafBase - 1; node > 0; node--) {
+		combine(node);
 	}
 }
 
 /*
- * findFreeBlocks
- * @param blocksNeeded: number of contiguous free blocks required
- * @param start: search start index (inclusive)
- * @param end: search end index (exclusive)
- * @return: address of the first byte of the found block group, or 0 if none
+ * nextFreeRun
+ * Finds the first run of free blocks starting at or after `from`, clipped
+ * to `to`, skipping whole words of used or free blocks at a time.
+ * @return: 1 and the run in `runStart`/`runLength`, or 0 if there is none
  */
-static uintptr_t findFreeBlocks(uint32_t blocksNeeded, uint32_t start, uint32_t end)
-{
-	uint32_t freeBlocks = 0;
-	uint32_t i;
-	for (i = start; i < end; i++) {
-		if (memoryManager.bitmap[i] == FREE) {
-			freeBlocks++;
-			if (freeBlocks == blocksNeeded) {
-				return (uintptr_t)(memoryManager.start + (i - blocksNeeded + 1) * BLOCK_SIZE);
-			}
-		} else {
-			freeBlocks = 0;
+static int nextFreeRun(uint32_t from, uint32_t to, uint32_t *runStart, uint32_t *runLength)
+{
+	uint32_t i = from;
+	while (i < to) {
+		uint64_t freeBits = ~memoryManager.bitmap[i / BITS_PER_WORD] >> (i % BITS_PER_WORD);
+		if (freeBits != 0) {
+			i += __builtin_ctzl(freeBits);
+			break;
 		}
+		i = (i / BITS_PER_WORD + 1) * BITS_PER_WORD;
 	}
-	if (freeBlocks == blocksNeeded) {
-		return (uintptr_t)(memoryManager.start + (i - blocksNeeded + 1) * BLOCK_SIZE);
+	if (i >= to) {
+		return 0;
 	}
-	return 0;
+	*runStart = i;
+
+	while (i < to) {
+		uint64_t usedBits = memoryManager.bitmap[i / BITS_PER_WORD] >> (i % BITS_PER_WORD);
+		if (usedBits != 0) {
+			i += __builtin_ctzl(usedBits);
+			break;
+		}
+		i = (i / BITS_PER_WORD + 1) * BITS_PER_WORD;
+	}
+	*runLength = (i < to ? i : to) - *runStart;
+	return 1;
 }
 
 /*
- * markGroupAsUsed
- * Marks a contiguous region of the bitmap as allocated using boundary
- * markers (START_BOUNDARY, END_BOUNDARY) and USED for inner blocks.
- * @param blocksNeeded: number of blocks in the group
- * @param index: starting block index in bitmap
- * @return: pointer to the payload start for the caller
+ * classOf
+ * @param length: length of a free run, in blocks (> 0)
+ * @return: mask with the bit of the power-of-two size class of `length`
  */
-static void *markGroupAsUsed(uint32_t blocksNeeded, uint32_t index)
+static uint32_t classOf(uint32_t length)
 {
-	memoryManager.bitmap[index] = START_BOUNDARY;
-	memoryManager.bitmap[index + blocksNeeded - 1] = END_BOUNDARY;
-	memoryManager.blocksUsed += 2;
-	for (uint32_t i = 1; i < blocksNeeded - 1; i++) {
-		memoryManager.blocksUsed++;
-		memoryManager.bitmap[index + i] = USED;
+	return 1U << (31 - __builtin_clz(length));
+}
+
+/*
+ * summarizeLeaf
+ * Recomputes the run summary of `leaf` from the used plane. Leaves past
+ * the end of the bitmap are fully used.
+ */
+static void summarizeLeaf(uint32_t leaf)
+{
+	runSummary *summary = &memoryManager.tree[memoryManager.leafBase + leaf];
+	summary->prefix = summary->suffix = summary->longest = summary->classes = 0;
+
+	uint32_t first = leaf * BLOCKS_PER_LEAF;
+	uint32_t last = first + BLOCKS_PER_LEAF;
+	uint32_t mapped = memoryManager.wordQty * BITS_PER_WORD;
+	if (first >= mapped) {
+		return;
+	}
+	if (last > mapped) {
+		last = mapped;
+	}
+
+	uint32_t runStart, runLength;
+	uint32_t position = first;
+	while (nextFreeRun(position, last, &runStart, &runLength)) {
+		if (runStart == first) {
+			summary->prefix = runLength;
+		}
+		if (runStart + runLength == last) {
+			summary->suffix = runLength;
+		}
+		if (runLength > summary->longest) {
+			summary->longest = runLength;
+		}
+		if (runStart != first && runStart + runLength != last) {
+			summary->classes |= classOf(runLength);
+		}
+		position = runStart + runLength;
 	}
-	return (void *)(memoryManager.start + index * BLOCK_SIZE);
+}
+
+/*
+ * combine
+ * Recomputes internal `node` from its two children.
+ */
+static void combine(uint32_t node)
+{
+	runSummary *left = &memoryManager.tree[2 * node];
+	runSummary *right = &memoryManager.tree[2 * node + 1];
+	runSummary *summary = &memoryManager.tree[node];
+	/* blocks covered by each child, from the depth of `node` */
+	uint32_t depth = 31 - __builtin_clz(node);
+	uint32_t half = BLOCKS_PER_LEAF << (memoryManager.leafShift - depth - 1);
+
+	summary->prefix = (left->prefix == half) ? half + right->prefix : left->prefix;
+	summary->suffix = (right->suffix == half) ? half + left->suffix : right->suffix;
+	summary->longest = left->suffix + right->prefix;
+	if (left->longest > summary->longest) {
+		summary->longest = left->longest;
+	}
+	if (right->longest > summary->longest) {
+		summary->longest = right->longest;
+	}
+	/* the run across the middle is inner unless it reaches an edge of `node` */
+	summary->classes = left->classes | right->classes;
+	uint32_t middle = left->suffix + right->prefix;
+	if (middle > 0 && left->suffix < half && right->prefix < half) {
+		summary->classes |= classOf(middle);
+	}
+}
+
+/*
+ * updateTree
+ * Refreshes the leaves covering blocks [index, index + count) and then
+ * their ancestors, one level at a time.
+ */
+static void updateTree(uint32_t index, uint32_t count)
+{
+	uint32_t low = index / BLOCKS_PER_LEAF;
+	uint32_t high = (index + count - 1) / BLOCKS_PER_LEAF;
+	for (uint32_t leaf = low; leaf <= high; leaf++) {
+		summarizeLeaf(leaf);
+	}
+	low += memoryManager.leafBase;
+	high += memoryManager.leafBase;
+	while (low > 1) {
+		low /= 2;
+		high /= 2;
+		for (uint32_t node = low; node <= high; node++) {
+			combine(node);
+		}
+	}
+}
+
+/*
+ * findInLeaf
+ * @param fitClass: 0 to take the first free run of at least `blocksNeeded`
+ *                  blocks, or the class mask of the inner run to take
+ * @return: start of the first matching free run inside `leaf`, or -1
+ */
+static int64_t findInLeaf(uint32_t leaf, uint32_t blocksNeeded, uint32_t fitClass)
+{
+	uint32_t first = leaf * BLOCKS_PER_LEAF;
+	uint32_t last = first + BLOCKS_PER_LEAF;
+	if (last > memoryManager.wordQty * BITS_PER_WORD) {
+		last = memoryManager.wordQty * BITS_PER_WORD;
+	}
+	uint32_t runStart, runLength;
+	uint32_t position = first;
+
+	while (nextFreeRun(position, last, &runStart, &runLength)) {
+		if (fitClass == 0 ? runLength >= blocksNeeded
+		                  : runStart != first && runStart + runLength != last && classOf(runLength) == fitClass) {
+			return runStart;
+		}
+		position = runStart + runLength;
+	}
+	return -1;
+}
+
+/*
+ * findBestFit
+ * Takes the lowest-addressed free run of the smallest size class whose
+ * runs all hold `blocksNeeded` blocks, found along one root-to-leaf path.
+ * The run is shorter than twice the request rounded up to a power of
+ * two. The edge runs of the root are checked first and last, since no
+ * node sees them as inner runs.
+ * @return: index of the first block of the run, or -1 if every run that
+ *          fits is in the class of `blocksNeeded` itself (or none fits)
+ */
+static int64_t findBestFit(uint32_t blocksNeeded)
+{
+	runSummary *tree = memoryManager.tree;
+	uint32_t total = memoryManager.leafBase * BLOCKS_PER_LEAF;
+	uint32_t prefixClass = tree[1].prefix > 0 ? classOf(tree[1].prefix) : 0;
+	uint32_t suffixClass = tree[1].suffix > 0 && tree[1].prefix < total ? classOf(tree[1].suffix) : 0;
+
+	/* classes starting at 2^ceil(log2(blocksNeeded)) */
+	uint32_t fitting = blocksNeeded > 1 ? ~0U << (32 - __builtin_clz(blocksNeeded - 1)) : ~0U;
+	uint32_t candidates = (tree[1].classes | prefixClass | suffixClass) & fitting;
+	if (candidates == 0) {
+		return -1;
+	}
+	uint32_t fitClass = candidates & -candidates;
+	if (prefixClass == fitClass) {
+		return 0;
+	}
+	if (!(tree[1].classes & fitClass)) {
+		return total - tree[1].suffix;
+	}
+
+	uint32_t node = 1;
+	uint32_t nodeStart = 0;
+	uint32_t half = total / 2;
+	while (node < memoryManager.leafBase) {
+		uint32_t left = 2 * node;
+		uint32_t middle = tree[left].suffix + tree[left + 1].prefix;
+		if (tree[left].classes & fitClass) {
+			node = left;
+		} else if (middle > 0 && tree[left].suffix < half && tree[left + 1].prefix < half &&
+		           classOf(middle) == fitClass) {
+			return nodeStart + half - tree[left].suffix;
+		} else {
+			nodeStart += half;
+			node = left + 1;
+		}
+		half /= 2;
+	}
+	return findInLeaf(node - memoryManager.leafBase, blocksNeeded, fitClass);
+}
+
+/*
+ * findFreeBlocks
+ * FIRST_FIT walks down the tree towards the lowest-addressed free run of
+ * `blocksNeeded` blocks; a run that straddles two children is found from
+ * the left child's suffix and the right child's prefix. BEST_FIT takes a
+ * run from the smallest size class that fits (see findBestFit) and falls
+ * back to FIRST_FIT when only runs of the request's own class are left.
+ * @param blocksNeeded: number of contiguous free blocks required
+ * @return: index of the first block of the found group, or -1 if none
+ */
+static int64_t findFreeBlocks(uint32_t blocksNeeded)
+{
+	runSummary *tree = memoryManager.tree;
+	if (tree[1].longest < blocksNeeded) {
+		return -1;
+	}
+
+	if (BITMAP_FIT == BEST_FIT) {
+		int64_t found = findBestFit(blocksNeeded);
+		if (found >= 0) {
+			return found;
+		}
+	}
+
+	uint32_t half = (memoryManager.leafBase * BLOCKS_PER_LEAF) / 2;
+
+	uint32_t node = 1;
+	uint32_t nodeStart = 0;
+	while (node < memoryManager.leafBase) {
+		uint32_t left = 2 * node;
+		uint32_t right = left + 1;
+		int goRight = tree[left].longest < blocksNeeded;
+
+		if (goRight && tree[left].suffix + tree[right].prefix >= blocksNeeded) {
+			return nodeStart + half - tree[left].suffix;
+		}
+
+		if (goRight) {
+			nodeStart += half;
+			node = right;
+		} else {
+			node = left;
+		}
+		half /= 2;
+	}
+	return findInLeaf(node - memoryManager.leafBase, blocksNeeded, 0);
 }
 
 void createMemoryManager(void *start, uint64_t size)
 {
 	/*
 	 * Layout in memory:
-	 * - bitmap table stored starting at HEAP_START_ADDRESS
-	 * - payload area follows the bitmap table
-	 * Compute how many physical blocks the bitmap itself consumes and
-	 * reduce the available block count accordingly.
+	 * - used plane, boundary plane and tree stored at `start`, rounded up
+	 *   to BLOCK_SIZE
+	 * - payload area follows them
+	 * Compute how many physical blocks the planes consume and reduce the
+	 * available block count accordingly.
 	 */
-	memoryManager.bitmap = (uint32_t *)HEAP_START_ADDRESS;
-	memoryManager.blockQty = HEAP_SIZE / BLOCK_SIZE;
+	uintptr_t first = ((uintptr_t)start + BLOCK_SIZE - 1) & ~(uintptr_t)(BLOCK_SIZE - 1);
+	uintptr_t end = ((uintptr_t)start + size) & ~(uintptr_t)(BLOCK_SIZE - 1);
+	memoryManager.blockQty = (end - first) / BLOCK_SIZE;
+	memoryManager.wordQty = (memoryManager.blockQty + BITS_PER_WORD - 1) / BITS_PER_WORD;
+	memoryManager.bitmap = (uint64_t *)first;
+	memoryManager.boundaries = memoryManager.bitmap + memoryManager.wordQty;
+	memoryManager.tree = (runSummary *)(memoryManager.boundaries + memoryManager.wordQty);
 
-	uint32_t bitmap_size_in_bytes = memoryManager.blockQty * sizeof(uint32_t);
-	uint32_t bitmap_size_in_blocks = (bitmap_size_in_bytes + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	uint32_t leafQty = (memoryManager.wordQty + WORDS_PER_LEAF - 1) / WORDS_PER_LEAF;
+	memoryManager.leafShift = 0;
+	while ((1U << memoryManager.leafShift) < leafQty) {
+		memoryManager.leafShift++;
+	}
+	memoryManager.leafBase = 1U << memoryManager.leafShift;
 
-	memoryManager.start = (void *)((uintptr_t)HEAP_START_ADDRESS + bitmap_size_in_blocks * BLOCK_SIZE);
-	/* reduce block count by the number of blocks consumed by the bitmap */
-	memoryManager.blockQty -= bitmap_size_in_blocks;
+	uint64_t planes_size_in_bytes = 2 * memoryManager.wordQty * sizeof(uint64_t) +
+	                                2 * memoryManager.leafBase * sizeof(runSummary);
+	uint32_t planes_size_in_blocks = (planes_size_in_bytes + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+	memoryManager.start = (void *)(first + planes_size_in_blocks * BLOCK_SIZE);
+	/* reduce block count by the number of blocks consumed by the planes */
+	memoryManager.blockQty -= planes_size_in_blocks;
 
 	memoryManager.blocksUsed = 0;
-	memoryManager.current = 0;
 	initializeBitmap();
 }
 
 void *allocMemory(uint64_t size)
 {
-	uint32_t blocksNeeded = sizeToBlockQty(size);
+	uint64_t blocksNeeded = sizeToBlockQty(size);
 
-	if (blocksNeeded > memoryManager.blockQty - memoryManager.blocksUsed) {
+	if (blocksNeeded == 0 || blocksNeeded > memoryManager.blockQty - memoryManager.blocksUsed) {
 		return NULL;
 	}
 
-	uintptr_t initialBlockAddress = findFreeBlocks(blocksNeeded, memoryManager.current, memoryManager.blockQty);
-
-	if (initialBlockAddress == 0) {
-		initialBlockAddress = findFreeBlocks(blocksNeeded, 0, memoryManager.blockQty);
-	}
-
-	if (initialBlockAddress == 0) {
+	int64_t blockIndex = findFreeBlocks(blocksNeeded);
+	if (blockIndex < 0) {
 		return NULL;
 	}
 
-	uint32_t blockIndex = (initialBlockAddress - (uintptr_t)memoryManager.start) / BLOCK_SIZE;
-	memoryManager.current = blockIndex + blocksNeeded;
-
-	/* handle single-block allocation as a special case */
-	if (blocksNeeded == 1) {
-		memoryManager.blocksUsed++;
-		memoryManager.bitmap[blockIndex] = SINGLE_BLOCK;
-		return (void *)initialBlockAddress;
-	}
-
-	return markGroupAsUsed(blocksNeeded, blockIndex);
+	setBits(memoryManager.bitmap, blockIndex, blocksNeeded, 1);
+	setBits(memoryManager.boundaries, blockIndex + blocksNeeded - 1, 1, 1);
+	updateTree(blockIndex, blocksNeeded);
+	memoryManager.blocksUsed += blocksNeeded;
+	return (void *)(memoryManager.start + blockIndex * BLOCK_SIZE);
 }
 
 void getMemoryInfo(memInfo *info)
@@ -151,8 +453,8 @@ void getMemoryInfo(memInfo *info)
 		return;
 	}
 
-	info->total = memoryManager.blockQty * BLOCK_SIZE;
-	info->used = memoryManager.blocksUsed * BLOCK_SIZE;
+	info->total = (uint64_t)memoryManager.blockQty * BLOCK_SIZE;
+	info->used = (uint64_t)memoryManager.blocksUsed * BLOCK_SIZE;
 	info->free = info->total - info->used;
 }
 
@@ -167,27 +469,30 @@ void freeMemory(void *address)
 		return;
 	}
 
-	uint32_t blockIndex = (blockAddress - (uintptr_t)memoryManager.start) / BLOCK_SIZE;
-
-	/* single-block allocation case */
-	if (memoryManager.bitmap[blockIndex] == SINGLE_BLOCK) {
-		memoryManager.bitmap[blockIndex] = FREE;
-		memoryManager.blocksUsed--;
+	uint64_t blockIndex = (blockAddress - (uintptr_t)memoryManager.start) / BLOCK_SIZE;
+	if (blockIndex >= memoryManager.blockQty || !testBit(memoryManager.bitmap, blockIndex)) {
 		return;
 	}
 
-	/* ensure this is the start boundary of a multi-block allocation */
-	if (memoryManager.bitmap[blockIndex] != START_BOUNDARY) {
+	/* ensure this is the first block of an allocation */
+	if (blockIndex > 0 && testBit(memoryManager.bitmap, blockIndex - 1) &&
+	    !testBit(memoryManager.boundaries, blockIndex - 1)) {
 		return;
 	}
 
-	uint32_t blocksToFree = 0;
-	while (memoryManager.bitmap[blockIndex + blocksToFree] != END_BOUNDARY) {
-		memoryManager.bitmap[blockIndex + blocksToFree] = FREE;
-		blocksToFree++;
+	/* the allocation ends at the next set bit of the boundary plane */
+	uint32_t word = blockIndex / BITS_PER_WORD;
+	uint64_t bits = memoryManager.boundaries[word] & (ALL_ONES << (blockIndex % BITS_PER_WORD));
+	while (bits == 0) {
+		bits = memoryManager.boundaries[++word];
 	}
-	memoryManager.bitmap[blockIndex + blocksToFree] = FREE;
-	memoryManager.blocksUsed -= blocksToFree + 1;
+	uint64_t lastIndex = (uint64_t)word * BITS_PER_WORD + __builtin_ctzl(bits);
+	uint32_t blocksToFree = lastIndex - blockIndex + 1;
+
+	setBits(memoryManager.bitmap, blockIndex, blocksToFree, 0);
+	setBits(memoryManager.boundaries, lastIndex, 1, 0);
+	updateTree(blockIndex, blocksToFree);
+	memoryManager.blocksUsed -= blocksToFree;
 }
 
 int getUsedMemory()
@@ -0,0 +1,182 @@
+#include <defs.h>
+#include <memoryManager.h>
+#include <slab.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define OBJ_ALIGN 8 /* objects keep 8-byte alignment, no further rounding */
+
+typedef struct slab {
+	kmem_cache_t *cache;
+	struct slab *next;
+	struct slab *prev;
+	void *freeList;      /* objects given back with kmem_cache_free */
+	uint8_t *nextUnused; /* bump pointer over objects never handed out */
+	uint32_t inUse;
+} slab_t;
+
+struct kmem_cache {
+	const char *name;
+	uint64_t objSize;
+	uint32_t objsPerSlab;
+	slab_t *partial; /* slabs with at least one free object */
+	uint64_t objsInUse;
+};
+
+static kmem_cache_t caches[MAX_CACHES];
+static uint32_t cacheCount = 0;
+static slab_t *freeSlabs = NULL; /* empty slabs shared by every cache */
+
+#define ALIGN_UP(x, a) (((x) + (a) - 1) & ~((uint64_t)(a) - 1))
+#define SLAB_OF(obj) ((slab_t *)((uintptr_t)(obj) & ~((uintptr_t)SLAB_SIZE - 1)))
+#define SLAB_HEADER_SIZE ALIGN_UP(sizeof(slab_t), OBJ_ALIGN)
+
+static int refillSlabs();
+static slab_t *getSlab(kmem_cache_t *cache);
+static void linkPartial(kmem_cache_t *cache, slab_t *slab);
+static void unlinkPartial(kmem_cache_t *cache, slab_t *slab);
+
+/*
+ * refillSlabs
+ * Requests SLAB_CHUNK_SIZE bytes from the memory manager and carves every
+ * SLAB_SIZE aligned slab that fits in it into the shared free pool. Chunks
+ * are never returned to the memory manager; the pool is bounded by the
+ * peak number of live slabs.
+ * @return: 0 on success, -1 if the memory manager is out of memory
+ */
+static int refillSlabs()
+{
+	uint8_t *chunk = allocMemory(SLAB_CHUNK_SIZE);
+	if (chunk == NULL) {
+		return -1;
+	}
+	uint8_t *end = chunk + SLAB_CHUNK_SIZE;
+	uint8_t *current = (uint8_t *)ALIGN_UP((uintptr_t)chunk, SLAB_SIZE);
+	for (; current + SLAB_SIZE <= end; current += SLAB_SIZE) {
+		slab_t *slab = (slab_t *)current;
+		slab->next = freeSlabs;
+		freeSlabs = slab;
+	}
+	return 0;
+}
+
+/*
+ * getSlab
+ * Takes an empty slab from the shared pool, prepares it for `cache` and
+ * links it as the first partial slab of that cache.
+ * @return: the new slab, or NULL if no memory is available
+ */
+static slab_t *getSlab(kmem_cache_t *cache)
+{
+	if (freeSlabs == NULL && refillSlabs() != 0) {
+		return NULL;
+	}
+	slab_t *slab = freeSlabs;
+	freeSlabs = slab->next;
+
+	slab->cache = cache;
+	slab->freeList = NULL;
+	slab->nextUnused = (uint8_t *)slab + SLAB_HEADER_SIZE;
+	slab->inUse = 0;
+	linkPartial(cache, slab);
+	return slab;
+}
+
+static void linkPartial(kmem_cache_t *cache, slab_t *slab)
+{
+	slab->prev = NULL;
+	slab->next = cache->partial;
+	if (cache->partial != NULL) {
+		cache->partial->prev = slab;
+	}
+	cache->partial = slab;
+}
+
+static void unlinkPartial(kmem_cache_t *cache, slab_t *slab)
+{
+	if (slab->prev != NULL) {
+		slab->prev->next = slab->next;
+	} else {
+		cache->partial = slab->next;
+	}
+	if (slab->next != NULL) {
+		slab->next->prev = slab->prev;
+	}
+	slab->next = NULL;
+	slab->prev = NULL;
+}
+
+kmem_cache_t *kmem_cache_create(const char *name, uint64_t size)
+{
+	if (size == 0 || cacheCount >= MAX_CACHES) {
+		return NULL;
+	}
+	/* the free-list link lives inside free objects */
+	if (size < sizeof(void *)) {
+		size = sizeof(void *);
+	}
+	size = ALIGN_UP(size, OBJ_ALIGN);
+	if (size > SLAB_SIZE - SLAB_HEADER_SIZE) {
+		return NULL;
+	}
+
+	kmem_cache_t *cache = &caches[cacheCount++];
+	cache->name = name;
+	cache->objSize = size;
+	cache->objsPerSlab = (SLAB_SIZE - SLAB_HEADER_SIZE) / size;
+	cache->partial = NULL;
+	cache->objsInUse = 0;
+	return cache;
+}
+
+void *kmem_cache_alloc(kmem_cache_t *cache)
+{
+	if (cache == NULL) {
+		return NULL;
+	}
+	slab_t *slab = cache->partial;
+	if (slab == NULL && (slab = getSlab(cache)) == NULL) {
+		return NULL;
+	}
+
+	void *obj;
+	if (slab->freeList != NULL) {
+		obj = slab->freeList;
+		slab->freeList = *(void **)obj;
+	} else {
+		obj = slab->nextUnused;
+		slab->nextUnused += cache->objSize;
+	}
+
+	/* full slabs leave the partial list until an object comes back */
+	if (++slab->inUse == cache->objsPerSlab) {
+		unlinkPartial(cache, slab);
+	}
+	cache->objsInUse++;
+	return obj;
+}
+
+void kmem_cache_free(kmem_cache_t *cache, void *obj)
+{
+	if (cache == NULL || obj == NULL) {
+		return;
+	}
+	slab_t *slab = SLAB_OF(obj);
+	if (slab->cache != cache || slab->inUse == 0) {
+		return;
+	}
+
+	*(void **)obj = slab->freeList;
+	slab->freeList = obj;
+	if (slab->inUse-- == cache->objsPerSlab) {
+		linkPartial(cache, slab);
+	}
+	cache->objsInUse--;
+
+	/* keep the last partial slab around so alloc/free pairs don't thrash the pool */
+	if (slab->inUse == 0 && (cache->partial != slab || slab->next != NULL)) {
+		unlinkPartial(cache, slab);
+		slab->next = freeSlabs;
+		freeSlabs = slab;
+	}
+}
@@ -0,0 +1,303 @@
+#ifdef TLSF
+#include <memoryManager.h>
+#include <defs.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Two-Level Segregated Fit allocator. Free blocks are kept in
+ * FL_INDEX_COUNT x SL_INDEX_COUNT (23 x 32) segregated lists: the first
+ * level splits sizes by power of two, the second level splits each power
+ * of two into SL_INDEX_COUNT equal ranges. A bitmap per level makes finding a
+ * non-empty list a couple of find-first-set operations, so allocation and
+ * free run in constant time regardless of heap state.
+ */
+#define ALIGN_LOG2 4
+#define ALIGN_SIZE (1UL << ALIGN_LOG2) /* payloads and block sizes are 16-byte aligned */
+#define SL_INDEX_COUNT_LOG2 5
+#define SL_INDEX_COUNT (1 << SL_INDEX_COUNT_LOG2)
+#define FL_INDEX_MAX 30 /* blocks are smaller than 2^(FL_INDEX_MAX + 1) bytes */
+#define FL_INDEX_SHIFT (SL_INDEX_COUNT_LOG2 + ALIGN_LOG2)
+#define FL_INDEX_COUNT (FL_INDEX_MAX - FL_INDEX_SHIFT + 2)
+#define SMALL_BLOCK_SIZE (1UL << FL_INDEX_SHIFT) /* below this, first level 0 is split linearly */
+
+#define BLOCK_FREE 0x1
+#define BLOCK_FLAGS (ALIGN_SIZE - 1)
+
+typedef struct blockHeader {
+	struct blockHeader *prevPhys; /* physically previous block, NULL for the first one */
+	uint64_t size;                /* payload bytes | flags */
+	struct blockHeader *nextFree; /* free-list links, only valid in free blocks */
+	struct blockHeader *prevFree;
+} blockHeader;
+
+#define HEADER_SIZE (offsetof(blockHeader, nextFree))
+#define MIN_BLOCK_SIZE (sizeof(blockHeader) - HEADER_SIZE)
+#define ALIGN_UP(x) (((x) + ALIGN_SIZE - 1) & ~(ALIGN_SIZE - 1))
+
+typedef struct MemoryManagerCDT {
+	uint32_t flBitmap;
+	uint32_t slBitmap[FL_INDEX_COUNT];
+	blockHeader *blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+	uintptr_t first;
+	uintptr_t end;
+	uint64_t total;
+	uint64_t used;
+} MemoryManagerCDT;
+
+static MemoryManagerCDT memoryManager;
+
+static uint64_t blockSize(blockHeader *block);
+static blockHeader *nextPhys(blockHeader *block);
+static void mappingInsert(uint64_t size, int *fl, int *sl);
+static void mappingSearch(uint64_t size, int *fl, int *sl);
+static void insertFree(blockHeader *block);
+static void removeFree(blockHeader *block);
+static blockHeader *findSuitable(int *fl, int *sl);
+static blockHeader *absorbNext(blockHeader *block);
+static int isAllocatedBlock(blockHeader *block);
+
+static uint64_t blockSize(blockHeader *block)
+{
+	return block->size & ~BLOCK_FLAGS;
+}
+
+static blockHeader *nextPhys(blockHeader *block)
+{
+	return (blockHeader *)((uint8_t *)block + HEADER_SIZE + blockSize(block));
+}
+
+/*
+ * mappingInsert
+ * @param size: block size in bytes
+ * @return: in `fl`/`sl`, the list a free block of `size` bytes belongs to
+ */
+static void mappingInsert(uint64_t size, int *fl, int *sl)
+{
+	if (size < SMALL_BLOCK_SIZE) {
+		*fl = 0;
+		*sl = size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+		return;
+	}
+	int top = 63 - __builtin_clzl(size);
+	*sl = (size >> (top - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+	*fl = top - (FL_INDEX_SHIFT - 1);
+}
+
+/*
+ * mappingSearch
+ * Like mappingInsert, but rounds `size` up to the next list boundary so
+ * that any block found in the resulting list (or a later one) fits.
+ */
+static void mappingSearch(uint64_t size, int *fl, int *sl)
+{
+	if (size >= SMALL_BLOCK_SIZE) {
+		size += (1UL << (63 - __builtin_clzl(size) - SL_INDEX_COUNT_LOG2)) - 1;
+	}
+	mappingInsert(size, fl, sl);
+}
+
+static void insertFree(blockHeader *block)
+{
+	int fl, sl;
+	mappingInsert(blockSize(block), &fl, &sl);
+	block->size |= BLOCK_FREE;
+	block->prevFree = NULL;
+	block->nextFree = memoryManager.blocks[fl][sl];
+	if (block->nextFree != NULL) {
+		block->nextFree->prevFree = block;
+	}
+	memoryManager.blocks[fl][sl] = block;
+	memoryManager.flBitmap |= 1U << fl;
+	memoryManager.slBitmap[fl] |= 1U << sl;
+}
+
+static void removeFree(blockHeader *block)
+{
+	int fl, sl;
+	mappingInsert(blockSize(block), &fl, &sl);
+	if (block->prevFree != NULL) {
+		block->prevFree->nextFree = block->nextFree;
+	} else {
+		memoryManager.blocks[fl][sl] = block->nextFree;
+	}
+	if (block->nextFree != NULL) {
+		block->nextFree->prevFree = block->prevFree;
+	}
+	if (memoryManager.blocks[fl][sl] == NULL) {
+		memoryManager.slBitmap[fl] &= ~(1U << sl);
+		if (memoryManager.slBitmap[fl] == 0) {
+			memoryManager.flBitmap &= ~(1U << fl);
+		}
+	}
+	block->size &= ~BLOCK_FREE;
+}
+
+/*
+ * findSuitable
+ * @return: head of the first non-empty list at or after (`fl`, `sl`),
+ *          updating both indexes, or NULL if there is none
+ */
+static blockHeader *findSuitable(int *fl, int *sl)
+{
+	uint32_t slMap = memoryManager.slBitmap[*fl] & (~0U << *sl);
+	if (slMap == 0) {
+		uint32_t flMap = (*fl + 1 < 32) ? memoryManager.flBitmap & (~0U << (*fl + 1)) : 0;
+		if (flMap == 0) {
+			return NULL;
+		}
+		*fl = __builtin_ctz(flMap);
+		slMap = memoryManager.slBitmap[*fl];
+	}
+	*sl = __builtin_ctz(slMap);
+	return memoryManager.blocks[*fl][*sl];
+}
+
+/*
+ * absorbNext
+ * Merges the physically next block, which must be free and already out of
+ * its list, into `block`.
+ * @return: `block`
+ */
+static blockHeader *absorbNext(blockHeader *block)
+{
+	blockHeader *next = nextPhys(block);
+	block->size += HEADER_SIZE + blockSize(next);
+	nextPhys(block)->prevPhys = block;
+	return block;
+}
+
+/*
+ * isAllocatedBlock
+ * Headers carry no magic (it would break the 16-byte payload alignment),
+ * so a pointer is checked against the physical chain instead: its size
+ * must be aligned and in range, and both physical neighbours must link
+ * back to it.
+ * @return: 1 if `block` heads an allocated block, 0 otherwise
+ */
+static int isAllocatedBlock(blockHeader *block)
+{
+	uintptr_t address = (uintptr_t)block;
+	if ((block->size & BLOCK_FLAGS) != 0 || blockSize(block) < MIN_BLOCK_SIZE ||
+	    blockSize(block) > memoryManager.end - address - HEADER_SIZE) {
+		return 0; /* free, or not a header */
+	}
+	if (nextPhys(block)->prevPhys != block) {
+		return 0;
+	}
+	blockHeader *prev = block->prevPhys;
+	if (prev == NULL) {
+		return address == memoryManager.first;
+	}
+	uintptr_t prevAddress = (uintptr_t)prev;
+	return prevAddress >= memoryManager.first && prevAddress < address && (prevAddress & (ALIGN_SIZE - 1)) == 0 &&
+	       nextPhys(prev) == block;
+}
+
+void createMemoryManager(void *start, uint64_t size)
+{
+	uintptr_t first = ALIGN_UP((uintptr_t)start);
+	uintptr_t end = ((uintptr_t)start + size) & ~(ALIGN_SIZE - 1);
+
+	memoryManager.flBitmap = 0;
+	for (int fl = 0; fl < FL_INDEX_COUNT; fl++) {
+		memoryManager.slBitmap[fl] = 0;
+		for (int sl = 0; sl < SL_INDEX_COUNT; sl++) {
+			memoryManager.blocks[fl][sl] = NULL;
+		}
+	}
+
+	/*
+	 * One free block spans the heap, followed by a zero-sized used sentinel
+	 * so that merging never looks past the end.
+	 */
+	uint64_t blockBytes = end - first - 2 * HEADER_SIZE;
+	if (blockBytes >> (FL_INDEX_MAX + 1)) {
+		blockBytes = (1UL << (FL_INDEX_MAX + 1)) - ALIGN_SIZE;
+	}
+	blockHeader *block = (blockHeader *)first;
+	block->prevPhys = NULL;
+	block->size = blockBytes;
+	blockHeader *sentinel = nextPhys(block);
+	sentinel->prevPhys = block;
+	sentinel->size = 0;
+	insertFree(block);
+
+	memoryManager.first = first;
+	memoryManager.end = (uintptr_t)sentinel;
+	memoryManager.total = HEADER_SIZE + blockBytes;
+	memoryManager.used = 0;
+}
+
+void *allocMemory(uint64_t size)
+{
+	if (size == 0 || size > (1UL << FL_INDEX_MAX)) {
+		return NULL;
+	}
+	size = ALIGN_UP(size);
+	if (size < MIN_BLOCK_SIZE) {
+		size = MIN_BLOCK_SIZE;
+	}
+
+	int fl, sl;
+	mappingSearch(size, &fl, &sl);
+	if (fl >= FL_INDEX_COUNT) {
+		return NULL;
+	}
+	blockHeader *block = findSuitable(&fl, &sl);
+	if (block == NULL) {
+		return NULL;
+	}
+	removeFree(block);
+
+	/* give the tail back if it can hold a block of its own */
+	if (blockSize(block) >= size + HEADER_SIZE + MIN_BLOCK_SIZE) {
+		blockHeader *rest = (blockHeader *)((uint8_t *)block + HEADER_SIZE + size);
+		rest->prevPhys = block;
+		rest->size = blockSize(block) - size - HEADER_SIZE;
+		nextPhys(rest)->prevPhys = rest;
+		block->size = size;
+		insertFree(rest);
+	}
+
+	memoryManager.used += HEADER_SIZE + blockSize(block);
+	return (uint8_t *)block + HEADER_SIZE;
+}
+
+void freeMemory(void *address)
+{
+	uintptr_t payload = (uintptr_t)address;
+	if (payload < memoryManager.first + HEADER_SIZE || payload >= memoryManager.end ||
+	    (payload & (ALIGN_SIZE - 1)) != 0) {
+		return;
+	}
+	blockHeader *block = (blockHeader *)(payload - HEADER_SIZE);
+	if (!isAllocatedBlock(block)) {
+		return; /* double free or stray pointer */
+	}
+	memoryManager.used -= HEADER_SIZE + blockSize(block);
+
+	blockHeader *prev = block->prevPhys;
+	if (prev != NULL && (prev->size & BLOCK_FREE)) {
+		removeFree(prev);
+		block = absorbNext(prev);
+	}
+	blockHeader *next = nextPhys(block);
+	if (next->size & BLOCK_FREE) {
+		removeFree(next);
+		absorbNext(block);
+	}
+	insertFree(block);
+}
+
+void getMemoryInfo(memInfo *info)
+{
+	if (info == NULL) {
+		return;
+	}
+	info->total = memoryManager.total;
+	info->used = memoryManager.used;
+	info->free = info->total - info->used;
+}
+
+#endif
@@ -12,6 +12,9 @@ GLOBAL _irq03Handler
 GLOBAL _irq04Handler
 GLOBAL _irq05Handler
 GLOBAL _irq80Handler
+GLOBAL _rescheduleHandler
+GLOBAL _syscallHandler
+GLOBAL _setupSyscallMSRs
 
 GLOBAL _exception0Handler
 GLOBAL _exception6Handler
@@ -121,6 +124,17 @@ _irq00Handler:
 	popState
 	iretq
 
+;Reschedule (int 81h): cambio de contexto voluntario, sin contar ticks ni EOI
+_rescheduleHandler:
+	pushState
+
+	mov rdi, rsp
+	call schedule
+	mov rsp, rax
+
+	popState
+	iretq
+
 ;Keyboard
 _irq01Handler:
 	pushState
@@ -138,21 +152,77 @@ _irq80Handler:
     mov rbp, rsp
     push rbx
 
-    ; Pasaje de parametros x86_64
+    ; Pasaje de parametros x86_64 (int 80h solo lleva tres parametros)
     mov rdi, rax  ; Número de syscall
     mov rsi, rbx  ; Primer parámetro
 	mov rax, rdx ;
     mov rdx, rcx  ; Segundo parámetro
     mov rcx, rax  ; Tercer parámetro
+    xor r8, r8
+    xor r9, r9
+    push 0        ; Sexto parámetro (alinea la pila a 16)
 
     ; Llamar a la función syscallDispatcher
     call syscallDispatcher
+	add rsp, 8
 	
 	pop rbx
 	mov rsp, rbp
 	pop rbp
     iretq
 
+;Fast syscall (instruccion SYSCALL): rax = numero, rdi, rsi, rdx, r10, r8, r9 = parametros
+;El CPU deja el RIP de retorno en rcx y RFLAGS en r11, y enmascara IF (FMASK).
+;Userland corre en ring 0 sobre la misma pila, asi que no hay cambio de stack
+;y se vuelve restaurando RFLAGS y saltando a rcx: SYSRET siempre baja a CPL 3.
+_syscallHandler:
+	push rcx
+	push r11
+
+	sub rsp, 8    ; alinea la pila a 16 en el call
+	push r9       ; Sexto parámetro
+	mov r9, r8    ; Quinto parámetro
+	mov r8, r10   ; Cuarto parámetro
+	mov rcx, rdx  ; Tercer parámetro
+	mov rdx, rsi  ; Segundo parámetro
+	mov rsi, rdi  ; Primer parámetro
+	mov rdi, rax  ; Número de syscall
+	call syscallDispatcher
+	add rsp, 16
+
+	pop r11
+	pop rcx
+	push r11
+	popfq
+	jmp rcx
+
+_setupSyscallMSRs:
+	; EFER.SCE habilita SYSCALL
+	mov ecx, 0C0000080h
+	rdmsr
+	or eax, 1
+	wrmsr
+
+	; STAR[47:32]: CS = 08h (SS = 10h) del GDT de Pure64
+	mov ecx, 0C0000081h
+	xor eax, eax
+	mov edx, 08h
+	wrmsr
+
+	; LSTAR: punto de entrada
+	mov ecx, 0C0000082h
+	mov rax, _syscallHandler
+	mov rdx, rax
+	shr rdx, 32
+	wrmsr
+
+	; FMASK: IF y DF en 0 al entrar
+	mov ecx, 0C0000084h
+	mov eax, 0600h
+	xor edx, edx
+	wrmsr
+	ret
+
 ;Zero Division Exception
 _exception0Handler:
 	exceptionHandler 0
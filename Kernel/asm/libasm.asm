@@ -2,7 +2,8 @@ GLOBAL cpuVendor
 GLOBAL kb_getKey
 GLOBAL outb
 GLOBAL inb
-GLOBAL callTimerTick
+GLOBAL callReschedule
+GLOBAL readTSC
 
 section .text
 	
@@ -66,6 +67,12 @@ inb:
 	pop rbp        
     ret     
 
-callTimerTick:
-	int 20h 
-	ret               
\ No newline at end of file
+callReschedule:
+	int 81h 
+	ret               
+
+readTSC:
+	rdtsc
+	shl rdx, 32
+	or rax, rdx
+	ret
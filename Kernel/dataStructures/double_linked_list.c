@@ -1,11 +1,19 @@
 #include "../include/double_linked_list.h"
 #include "../include/memoryManager.h"
+#include "../include/slab.h"
 #include <stddef.h>
 #include <stdint.h>
 
+static kmem_cache_t *listCache = NULL;
+static kmem_cache_t *nodeCache = NULL;
+
 DoubleLinkedListADT createDoubleLinkedList()
 {
-	void *mem = allocMemory(sizeof(DoubleLinkedListCDT));
+	if (listCache == NULL) {
+		listCache = kmem_cache_create("dll", sizeof(DoubleLinkedListCDT));
+		nodeCache = kmem_cache_create("dll_node", sizeof(Node));
+	}
+	void *mem = kmem_cache_alloc(listCache);
 	DoubleLinkedListADT list = (DoubleLinkedListADT)mem;
 	if (!list)
 		return NULL;
@@ -17,7 +25,7 @@ DoubleLinkedListADT createDoubleLinkedList()
 
 static Node *createNode(void *data)
 {
-	void *mem = allocMemory(sizeof(Node));
+	void *mem = kmem_cache_alloc(nodeCache);
 	Node *n = (Node *)mem;
 	if (!n)
 		return NULL;
@@ -71,7 +79,7 @@ int removeFirst(DoubleLinkedListADT list)
 		list->first->prev = NULL;
 	else
 		list->last = NULL;
-	freeMemory(n);
+	kmem_cache_free(nodeCache, n);
 	list->size--;
 	return 0;
 }
@@ -86,7 +94,7 @@ int removeLast(DoubleLinkedListADT list)
 		list->last->next = NULL;
 	else
 		list->first = NULL;
-	freeMemory(n);
+	kmem_cache_free(nodeCache, n);
 	list->size--;
 	return 0;
 }
@@ -106,7 +114,7 @@ int removeElement(DoubleLinkedListADT list, void *data)
 				it->next->prev = it->prev;
 			else
 				list->last = it->prev;
-			freeMemory(it);
+			kmem_cache_free(nodeCache, it);
 			list->size--;
 			return 0;
 		}
@@ -150,9 +158,9 @@ int freeList(DoubleLinkedListADT list)
 	Node *it = list->first;
 	while (it) {
 		Node *next = it->next;
-		freeMemory(it);
+		kmem_cache_free(nodeCache, it);
 		it = next;
 	}
-	freeMemory(list);
+	kmem_cache_free(listCache, list);
 	return 0;
 }
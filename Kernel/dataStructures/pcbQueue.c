@@ -0,0 +1,56 @@
+#include <pcbQueue.h>
+#include <stddef.h>
+
+#define PCB_OF(node) ((PCB *)((uint8_t *)(node) - offsetof(PCB, queueLink)))
+
+void initPCBQueue(PCBQueue *queue)
+{
+	queue->head.next = &queue->head;
+	queue->head.prev = &queue->head;
+	queue->size = 0;
+}
+
+void pushPCB(PCBQueue *queue, PCB *process)
+{
+	ListNode *link = &process->queueLink;
+	link->next = &queue->head;
+	link->prev = queue->head.prev;
+	queue->head.prev->next = link;
+	queue->head.prev = link;
+	process->queue = queue;
+	queue->size++;
+}
+
+PCB *popPCB(PCBQueue *queue)
+{
+	if (queue->size == 0) {
+		return NULL;
+	}
+	PCB *process = PCB_OF(queue->head.next);
+	removePCB(queue, process);
+	return process;
+}
+
+PCB *peekPCB(PCBQueue *queue)
+{
+	return queue->size == 0 ? NULL : PCB_OF(queue->head.next);
+}
+
+int removePCB(PCBQueue *queue, PCB *process)
+{
+	if (process == NULL || process->queue != queue) {
+		return -1;
+	}
+	ListNode *link = &process->queueLink;
+	link->prev->next = link->next;
+	link->next->prev = link->prev;
+	link->next = link->prev = NULL;
+	process->queue = NULL;
+	queue->size--;
+	return 0;
+}
+
+int isPCBQueueEmpty(PCBQueue *queue)
+{
+	return queue->size == 0;
+}
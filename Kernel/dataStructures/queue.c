@@ -1,6 +1,7 @@
 #include <defs.h>
 #include <memoryManager.h>
 #include <queue.h>
+#include <slab.h>
 #include <stddef.h>
 
 typedef struct Node {
@@ -14,9 +15,16 @@ typedef struct Queue {
 	int size;
 } Queue;
 
+static kmem_cache_t *queueCache = NULL;
+static kmem_cache_t *nodeCache = NULL;
+
 QueueADT createQueue()
 {
-	QueueADT queue = (QueueADT)allocMemory(sizeof(Queue));
+	if (queueCache == NULL) {
+		queueCache = kmem_cache_create("queue", sizeof(Queue));
+		nodeCache = kmem_cache_create("queue_node", sizeof(Node));
+	}
+	QueueADT queue = (QueueADT)kmem_cache_alloc(queueCache);
 	if (queue == NULL) {
 		return NULL;
 	}
@@ -34,10 +42,10 @@ void freeQueue(QueueADT queue)
 	Node *current = queue->front;
 	while (current != NULL) {
 		Node *next = current->next;
-		freeMemory(current);
+		kmem_cache_free(nodeCache, current);
 		current = next;
 	}
-	freeMemory(queue);
+	kmem_cache_free(queueCache, queue);
 }
 
 int enqueue(QueueADT queue, void *data)
@@ -45,7 +53,7 @@ int enqueue(QueueADT queue, void *data)
 	if (queue == NULL) {
 		return -1;
 	}
-	Node *newNode = (Node *)allocMemory(sizeof(Node));
+	Node *newNode = (Node *)kmem_cache_alloc(nodeCache);
 	if (newNode == NULL) {
 		return -1;
 	}
@@ -75,7 +83,7 @@ void *dequeue(QueueADT queue)
 	if (queue->front == NULL) {
 		queue->rear = NULL;
 	}
-	freeMemory(temp);
+	kmem_cache_free(nodeCache, temp);
 	queue->size--;
 	return data;
 }
@@ -112,7 +120,7 @@ void clearQueue(QueueADT queue)
 	Node *current = queue->front;
 	while (current != NULL) {
 		Node *next = current->next;
-		freeMemory(current);
+		kmem_cache_free(nodeCache, current);
 		current = next;
 	}
 	queue->front = NULL;
@@ -154,7 +162,7 @@ void *remove(QueueADT queue, void *data, int (*compare)(void *, void *))
 				queue->rear = previous;
 			}
 			void *removedData = current->data;
-			freeMemory(current);
+			kmem_cache_free(nodeCache, current);
 			queue->size--;
 			return removedData;
 		}
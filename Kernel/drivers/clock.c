@@ -8,11 +8,17 @@
 #define Y2K 2000
 #define CANT_PARAM 6
 
+/* callers must keep interrupts disabled between the two ports */
+static uint8_t rtcRead(unsigned char reg) {
+    outb(0x70, 128 | reg); // 128 = 10000000b
+    return inb(0x71);
+}
+
 uint8_t rtc(unsigned char reg) {
     _cli();
-    outb(0x70, 128 | reg); // 128 = 10000000b
+    uint8_t value = rtcRead(reg);
     _sti();
-    return inb(0x71);
+    return value;
 }
 
 enum RTC_REGS {SECONDS = 0x00, MINUTES = 0x02, HOURS = 0x04, DAY_OF_MONTH = 0x07, MONTH = 0x08, YEAR = 0x09};
@@ -43,6 +49,15 @@ uint8_t year(){
     return BCDToDecimal(rtc(YEAR));
 }
 
+void readWallClock(wallClock *clock) {
+    clock->sec = BCDToDecimal(rtcRead(SECONDS));
+    clock->min = BCDToDecimal(rtcRead(MINUTES));
+    clock->hour = BCDToDecimal(rtcRead(HOURS));
+    clock->day = BCDToDecimal(rtcRead(DAY_OF_MONTH));
+    clock->month = BCDToDecimal(rtcRead(MONTH));
+    clock->year = BCDToDecimal(rtcRead(YEAR)) + Y2K;
+}
+
 int isLeapYear(int year){ // From K&R - The C Programming Language
     return ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0);
 }
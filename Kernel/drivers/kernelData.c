@@ -0,0 +1,51 @@
+#include <clock.h>
+#include <kernelData.h>
+#include <lib.h>
+
+static kernelData *const page = (kernelData *)KERNEL_DATA_ADDRESS;
+static uint64_t tscAtSecond = 0;
+
+/* seqlock: readers retry while the sequence is odd or changed under them */
+static void beginWrite()
+{
+	page->sequence++;
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+static void endWrite()
+{
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+	page->sequence++;
+}
+
+void initKernelData(uint64_t tickHz)
+{
+	memset(page, 0, sizeof(kernelData));
+	page->tickHz = tickHz;
+	page->pid = -1;
+	tscAtSecond = readTSC();
+	page->tscAtTick = tscAtSecond;
+	readWallClock(&page->clock);
+}
+
+void kernelDataTick(uint64_t ticks)
+{
+	uint64_t tsc = readTSC();
+	beginWrite();
+	page->ticks = ticks;
+	page->tscAtTick = tsc;
+	if (ticks % page->tickHz == 0) {
+		page->tscPerTick = (tsc - tscAtSecond) / page->tickHz;
+		tscAtSecond = tsc;
+		readWallClock(&page->clock);
+	}
+	endWrite();
+}
+
+void kernelDataSetProcess(PCB *process)
+{
+	beginWrite();
+	page->pid = process->pid;
+	page->heapBase = process->heapBase;
+	endWrite();
+}
@@ -4,12 +4,19 @@
 #include <interrupts.h>
 #include <scheduler.h>
 #include <clock.h>
+#include <kernelData.h>
 
 static uint64_t ticks = 0;
 static uint16_t frequency = 18;
 
 void timer_handler() {
 	ticks++;
+	kernelDataTick(ticks);
+	schedulerTick(ticks);
+}
+
+uint64_t current_tick() {
+	return ticks;
 }
 
 int ticks_elapsed() {
@@ -19,6 +26,10 @@ int ticks_elapsed() {
 	return t;
 }
 
+uint16_t timer_frequency() {
+	return frequency;
+}
+
 int seconds_elapsed() {
 	_cli();
 	int t = ticks / frequency;
@@ -27,16 +38,18 @@ int seconds_elapsed() {
 }
 
 void wait_ticks(uint64_t ticksToWait) {
-	uint64_t currentTicks;
+	if (ticksToWait == 0) {
+		return;
+	}
+	/* runs in syscall context: the dispatcher turns interrupts back on at exit */
 	_cli();
-	currentTicks = ticks;
-	_sti();
-	uint64_t targetTicks = currentTicks + ticksToWait;
-	while (currentTicks < targetTicks) {
+	uint64_t targetTicks = ticks + ticksToWait;
+	/* sleep on the timer wheel; only processes that cannot block poll below */
+	if (sleepUntil(targetTicks) == 0) {
+		return;
+	}
+	while (ticks < targetTicks) {
 		yield();
-		_cli();
-		currentTicks = ticks;
-		_sti();
 	}
 }
 
@@ -0,0 +1,39 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "../../Shared/shared_structs.h"
+#include <stdint.h>
+
+/*
+ * initArena
+ * @param owner: process whose arena is initialized (empty)
+ */
+void initArena(PCB *owner);
+
+/*
+ * arenaAlloc
+ * Allocates `size` bytes from the memory manager and links them into the
+ * arena of `owner`, so they are released together with the process. The
+ * block carries no header: its size and alignment are those of allocMemory.
+ * @param owner: process that owns the allocation
+ * @param size: number of bytes to allocate
+ * @return: pointer to allocated memory, or NULL on failure
+ */
+void *arenaAlloc(PCB *owner, uint64_t size);
+
+/*
+ * arenaFree
+ * Unlinks a block returned by arenaAlloc from its owner's arena and frees
+ * it. Any process may free it, not just the owner.
+ * @param address: pointer returned by arenaAlloc (anything else is ignored)
+ */
+void arenaFree(void *address);
+
+/*
+ * releaseArena
+ * Frees every block still held in the arena of `owner` in one pass.
+ * @param owner: process whose arena is released
+ */
+void releaseArena(PCB *owner);
+
+#endif
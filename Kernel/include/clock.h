@@ -1,6 +1,7 @@
 #ifndef CLOCK_H
 #define CLOCK_H
 
+#include "../../Shared/shared_structs.h"
 #include <stdint.h>
 
 typedef struct time{
@@ -27,6 +28,14 @@ time_t getTime(int64_t timeZone);
  */
 uint64_t getTimeParam(uint64_t param);
 
+/*
+ * readWallClock
+ * Reads the RTC (UTC, no time zone applied) without touching the interrupt
+ * flag, so it must be called with interrupts disabled (e.g. from an IRQ).
+ * @param clock: filled with the current date and time
+ */
+void readWallClock(wallClock *clock);
+
 /*
  * diffTimeMillis
  * @param start: start time
@@ -26,6 +26,8 @@
 /* Address reserved for the semaphore manager data structure */
 #define SEMAPHORE_MANAGER_ADDRESS 0x60000
 
+/* The page below the heap (0x5FF000) is reserved for KERNEL_DATA_ADDRESS, see shared_structs.h */
+
 /* Heap bounds and related helpers */
 #define HEAP_START_ADDRESS 0x600000                          /* heap start address */
 #define HEAP_END_ADDRESS (512 * 1024 * 1024 - 1)             /* heap end (physical memory end) */
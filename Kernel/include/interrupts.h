@@ -19,6 +19,11 @@ void _irq04Handler(void);
 void _irq05Handler(void);
 
 void _irq80Handler(void);
+void _rescheduleHandler(void);
+void _syscallHandler(void);
+
+// Habilita SYSCALL y apunta LSTAR a _syscallHandler
+void _setupSyscallMSRs(void);
 
 void _exception0Handler(void);
 void _exception6Handler(void);
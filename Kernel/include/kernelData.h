@@ -0,0 +1,29 @@
+#ifndef KERNEL_DATA_H
+#define KERNEL_DATA_H
+
+#include "../../Shared/shared_structs.h"
+#include <stdint.h>
+
+/*
+ * initKernelData
+ * Clears the shared page at KERNEL_DATA_ADDRESS and publishes the tick rate
+ * and the current wall-clock time.
+ * @param tickHz: timer ticks per second
+ */
+void initKernelData(uint64_t tickHz);
+
+/*
+ * kernelDataTick
+ * Publishes the tick count and TSC; refreshes the TSC calibration and the
+ * wall clock once per second. Called from the timer interrupt.
+ */
+void kernelDataTick(uint64_t ticks);
+
+/*
+ * kernelDataSetProcess
+ * Publishes the pid and heapBase of the process being dispatched, or of the
+ * running one when its heapBase changes.
+ */
+void kernelDataSetProcess(PCB *process);
+
+#endif
@@ -15,6 +15,7 @@ uint64_t *getRegisters();
 
 void outb(uint16_t port, uint8_t val);
 uint8_t inb(uint16_t port);
-void callTimerTick();
+void callReschedule();
+uint64_t readTSC();
 
 #endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef PCB_QUEUE_H
+#define PCB_QUEUE_H
+
+#include "../../Shared/shared_structs.h"
+#include <stdint.h>
+
+/*
+ * Intrusive FIFO of processes: the links live in the PCB (`queueLink`), so
+ * queue operations never allocate and a known PCB is unlinked in O(1). A
+ * PCB is in at most one queue at a time, recorded in its `queue` field.
+ */
+typedef struct PCBQueue {
+	ListNode head; /* sentinel of the circular list */
+	uint64_t size;
+} PCBQueue;
+
+/*
+ * initPCBQueue
+ * @param queue: queue to initialize as empty
+ */
+void initPCBQueue(PCBQueue *queue);
+
+/*
+ * pushPCB
+ * Appends `process` at the tail of `queue`. The process must not be
+ * linked in any queue.
+ */
+void pushPCB(PCBQueue *queue, PCB *process);
+
+/*
+ * popPCB
+ * Unlinks and returns the head of `queue`.
+ * @return: PCB at the head, or NULL if the queue is empty
+ */
+PCB *popPCB(PCBQueue *queue);
+
+/*
+ * peekPCB
+ * @return: PCB at the head of `queue` without removing it, or NULL if empty
+ */
+PCB *peekPCB(PCBQueue *queue);
+
+/*
+ * removePCB
+ * Unlinks `process` from `queue` in O(1).
+ * @return: 0 on success, -1 if `process` is not linked in `queue`
+ */
+int removePCB(PCBQueue *queue, PCB *process);
+
+/*
+ * isPCBQueueEmpty
+ * @return: non-zero if `queue` has no processes
+ */
+int isPCBQueueEmpty(PCBQueue *queue);
+
+#endif /* PCB_QUEUE_H */
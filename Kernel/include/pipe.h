@@ -3,17 +3,25 @@
 
 #include <semaphore.h>
 
-#define PIPE_BUFFER_SIZE 100
+#define PIPE_DEFAULT_SIZE 4096 /* capacity used when none is requested */
+#define PIPE_MIN_SIZE 16
+#define PIPE_MAX_SIZE (1 << 20)
 #define MAX_PIPES 16
 
 typedef struct {
-    char buffer[PIPE_BUFFER_SIZE];
+    char *buffer;       /* allocated from the kernel heap */
+    int size;           /* capacity, a power of two: indices are masked with size - 1 */
     int readIdx;
     int writeIdx;
     int count;
-    int semReaders;
-    int semWriters; 
-    int mutex;         
+    int semReaders;     /* posted when data arrives and a reader is waiting */
+    int semWriters;     /* posted when space frees and a writer is waiting */
+    int mutex;
+    int readersWaiting; /* readers sleeping on semReaders (a flag in SPSC mode) */
+    int writersWaiting; /* writers sleeping on semWriters (a flag in SPSC mode) */
+    int spsc;           /* PIPE_SPSC: uses head/tail instead of the mutex */
+    uint32_t head;      /* SPSC: bytes ever read, only moved by the reader */
+    uint32_t tail;      /* SPSC: bytes ever written, only moved by the writer */
     int readers;
     int writers;
     int isOpen;
@@ -36,14 +44,27 @@ void createPipeManager();
 /*
  * createPipe
  * Creates a new pipe and returns its id.
+ * @param size: capacity in bytes, rounded up to a power of two and clamped
+ *              to [PIPE_MIN_SIZE, PIPE_MAX_SIZE]; 0 selects PIPE_DEFAULT_SIZE
+ * @param flags: PIPE_SPSC if the pipe has exactly one reader and one writer
  * @return: pipe id (>=0) on success, -1 on failure
  */
-int createPipe();
+int createPipe(int size, int flags);
+
+/*
+ * pipeResize
+ * Replaces the buffer of pipe `pipe_id` with one of `size` bytes (rounded
+ * like in createPipe), keeping the buffered data.
+ * @return: new capacity on success, -1 if the id is invalid, the pipe is
+ *          PIPE_SPSC, the data does not fit or there is no memory
+ */
+int pipeResize(int pipe_id, int size);
 
 /*
  * pipeRead
  * Reads up to `size` bytes from pipe `pipe_id` into `buffer`.
- * This function may block depending on pipe semantics.
+ * Blocks only while the pipe is empty, then copies every available byte
+ * (up to `size`) in one go.
  * @param pipe_id: id of the pipe to read from
  * @param buffer: destination buffer (must be at least `size` bytes)
  * @param size: number of bytes requested to read
@@ -53,7 +74,8 @@ int pipeRead(int pipe_id, char *buffer, int size);
 
 /*
  * pipeWrite
- * Writes up to `size` bytes from `buffer` into pipe `pipe_id`.
+ * Writes `size` bytes from `buffer` into pipe `pipe_id`, copying as much as
+ * fits at a time and blocking while the pipe is full.
  * @param pipe_id: id of the pipe to write to
  * @param buffer: source buffer
  * @param size: number of bytes to write
@@ -71,7 +93,8 @@ int pipeClose(int pipe_id);
 
 /*
  * pipeClear
- * Empties the pipe buffer without closing the pipe.
+ * Empties the pipe buffer without closing the pipe. On a PIPE_SPSC pipe only
+ * the reader may call it.
  * @param pipe_id: id of the pipe to clear
  * @return: 0 on success, -1 on failure
  */
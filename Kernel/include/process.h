@@ -8,6 +8,10 @@
 
 #define KERNEL_STACK_SIZE 4096
 #define PROCESS_STACK_SIZE 4096
+#define MAX_PRIORITY 5  /* least urgent schedulable priority */
+#define MIN_PRIORITY 0  /* most urgent priority */
+#define IDLE_PRIORITY 6 /* reserved for the idle process */
+#define PROCESS_TABLE_SIZE 512 /* power of two, bounds live processes to PROCESS_TABLE_SIZE - 1 */
 
 extern int processes_sem;
 
@@ -51,6 +55,34 @@ void removeFromReady(ProcessManagerADT pm, pid_t pid);
  */
 void removeFromZombie(ProcessManagerADT pm, pid_t pid);
 
+/*
+ * registerProcess
+ * Inserts `process` into the pid table so getProcess finds it in O(1).
+ * @return: 0 on success, -1 if the table is full or the pid is taken
+ */
+int registerProcess(ProcessManagerADT pm, PCB *process);
+
+/*
+ * unregisterProcess
+ * Removes the process with `pid` from the pid table (if present).
+ */
+void unregisterProcess(ProcessManagerADT pm, pid_t pid);
+
+/*
+ * nextProcessInTable
+ * Iterates over every live process in table order.
+ * @param cursor: iteration state, start at 0
+ * @return: next PCB, or NULL when the iteration is over
+ */
+PCB *nextProcessInTable(ProcessManagerADT pm, uint64_t *cursor);
+
+/*
+ * updateReadyPriority
+ * Requeues a ready `process` at the level of its (changed) priority. Does
+ * nothing if the process is not ready.
+ */
+void updateReadyPriority(ProcessManagerADT pm, PCB *process);
+
 /* queue switches / blocking */
 /*
  * blockProcessQueue
@@ -66,6 +98,28 @@ int blockProcessQueue(ProcessManagerADT list, pid_t pid);
  */
 int blockProcessQueueBySem(ProcessManagerADT list, pid_t pid);
 
+/*
+ * setProcessState
+ * Changes the state of `process`, charging the time spent in the previous
+ * state to its READY or BLOCKED counters.
+ */
+void setProcessState(PCB *process, State state);
+
+/*
+ * sleepProcessQueue
+ * Moves the ready process `pid` to the timer wheel until `wakeTick`.
+ * @return: 0 on success, -1 if the process is not ready
+ */
+int sleepProcessQueue(ProcessManagerADT pm, pid_t pid, uint64_t wakeTick);
+
+/*
+ * wakeSleepingProcesses
+ * Makes ready every sleeping process whose wake-up tick is `now` or
+ * earlier. Only the wheel slot of `now` is visited, so it must be called
+ * on every tick.
+ */
+void wakeSleepingProcesses(ProcessManagerADT pm, uint64_t now);
+
 /*
  * unblockProcessQueue
  * Unblocks a process with `pid` and moves it back to ready queue.
@@ -98,11 +152,21 @@ PCB *getNextReadyProcess(ProcessManagerADT pm);
 
 /*
  * getNextProcess
- * Returns next process for scheduling (may remove or return depending on impl).
+ * Picks the head of the most urgent non-empty ready level in O(1) and
+ * rotates it to the tail of its level. Periodically ages waiting processes.
  * @return: pointer to PCB or NULL if none
  */
 PCB *getNextProcess(ProcessManagerADT pm);
 
+/*
+ * takeReadyProcess
+ * Like getNextProcess, but picks the ready process `pid` ahead of the others
+ * at its level. Used to hand the CPU directly to a process that was just woken.
+ * @return: pointer to PCB, or NULL if `pid` is not ready or a more urgent
+ *          level has a ready process (`pid` is left queued)
+ */
+PCB *takeReadyProcess(ProcessManagerADT pm, pid_t pid);
+
 /*
  * hasNextReadyProcess
  * @return: non-zero if there is at least one ready process, 0 otherwise
@@ -36,10 +36,11 @@ void startScheduler(processFun idle);
  * @param foreground: non-zero for foreground, 0 for background
  * @param stdin: initial stdin file descriptor
  * @param stdout: initial stdout file descriptor
+ * @param stackSize: stack size in bytes, rounded up to a pool class (0 for the default)
  * @return: pid_t of created process, or -1 on failure
  */
 pid_t createProcess(char *name, processFun function, uint64_t argc, char **arg, uint8_t priority, char foreground,
-                    int stdin, int stdout);
+                    int stdin, int stdout, uint64_t stackSize);
 
 /*
  * getCurrentPid
@@ -47,6 +48,12 @@ pid_t createProcess(char *name, processFun function, uint64_t argc, char **arg,
  */
 pid_t getCurrentPid();
 
+/*
+ * getCurrentPCB
+ * @return: PCB of the current running process, or NULL if none
+ */
+PCB *getCurrentPCB();
+
 /*
  * getForegroundPid
  * @return: pid_t of the foreground process, or -1 if none
@@ -60,6 +67,27 @@ pid_t getForegroundPid();
  */
 uint64_t blockProcess(pid_t pid);
 
+/*
+ * sleepUntil
+ * Blocks the current process until the tick count reaches `wakeTick`.
+ * @return: 0 after waking up, -1 if the process cannot sleep (e.g. idle)
+ */
+uint64_t sleepUntil(uint64_t wakeTick);
+
+/*
+ * schedulerTick
+ * Called on every timer tick: charges the tick to the running process and
+ * wakes the processes due at `now`.
+ */
+void schedulerTick(uint64_t now);
+
+/*
+ * getSchedulerInfo
+ * Fills `info` with the tick count, the number of context switches and the
+ * 1, 5 and 15 minute load averages.
+ */
+void getSchedulerInfo(sysInfo *info);
+
 /*
  * yield
  * Voluntarily yields CPU to the next process (no parameters, no return)
@@ -109,6 +137,23 @@ uint64_t blockProcessBySem(pid_t pid);
  */
 uint64_t unblockProcessBySem(pid_t pid);
 
+/*
+ * discardWakeupHandoff
+ * Drops a handoff recorded outside a syscall, e.g. by a post from an
+ * interrupt handler. Called on syscall entry, so preemptOnWakeup only acts on
+ * posts made by the syscall itself.
+ */
+void discardWakeupHandoff();
+
+/*
+ * preemptOnWakeup
+ * Switches to the process woken by the last semaphore post if it is at least
+ * as urgent as the current one (see WAKEUP_PREEMPTION). Called on syscall
+ * exit, where no kernel lock is held. Any other switch drops a pending
+ * handoff instead of taking it.
+ */
+void preemptOnWakeup();
+
 /*
  * getProcessInfo
  * Fills an array of PCBs describing current processes (caller owns returned array)
@@ -117,9 +162,21 @@ uint64_t unblockProcessBySem(pid_t pid);
  */
 PCB *getProcessInfo(uint64_t *cantProcesses);
 
+/*
+ * getProcessStats
+ * Fills `buffer` with up to `capacity` compact records, resuming the walk of
+ * the process table at `*cursor` (0 to start) and advancing it. Nothing is
+ * allocated and no kernel addresses are exposed. Processes that exit between
+ * calls may shift others to earlier slots, so a walk is a best-effort view.
+ * @return: number of records written, 0 once the table is exhausted
+ */
+uint64_t getProcessStats(uint64_t *cursor, procStat *buffer, uint64_t capacity);
+
 /*
  * copyProcess
- * Copies the contents of `src` into `dest` safely.
+ * Copies the fields of `src` that ps shows into `dest`. Every other field of
+ * `dest`, such as the arena and queue links or the ring and heap pointers,
+ * is zeroed.
  * @return: 0 on success, -1 on failure
  */
 int16_t copyProcess(PCB *dest, PCB *src);
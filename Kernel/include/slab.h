@@ -0,0 +1,38 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdint.h>
+
+#define SLAB_SIZE 4096                     /* bytes per slab, slabs are SLAB_SIZE aligned */
+#define SLAB_CHUNK_SIZE (16 * SLAB_SIZE)   /* bytes requested from the memory manager per refill */
+#define MAX_CACHES 16
+
+typedef struct kmem_cache kmem_cache_t;
+
+/*
+ * kmem_cache_create
+ * Creates an object cache for fixed-size objects of `size` bytes. Objects
+ * are carved from SLAB_SIZE slabs obtained from the memory manager.
+ * @param name: descriptive name of the cache (not copied)
+ * @param size: object size in bytes
+ * @return: pointer to the new cache, or NULL on failure
+ */
+kmem_cache_t *kmem_cache_create(const char *name, uint64_t size);
+
+/*
+ * kmem_cache_alloc
+ * Allocates one object from `cache` in O(1).
+ * @param cache: cache returned by kmem_cache_create
+ * @return: pointer to the object, or NULL if no memory is available
+ */
+void *kmem_cache_alloc(kmem_cache_t *cache);
+
+/*
+ * kmem_cache_free
+ * Returns `obj` to `cache` in O(1). Empty slabs go back to a shared pool.
+ * @param cache: cache the object was allocated from
+ * @param obj: pointer previously returned by kmem_cache_alloc (NULL is ignored)
+ */
+void kmem_cache_free(kmem_cache_t *cache, void *obj);
+
+#endif /* SLAB_H */
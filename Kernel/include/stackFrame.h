@@ -5,12 +5,14 @@
  * setUpStackFrame
  * Prepares the initial stack frame for a new process.
  * @param stackBase: pointer to the base/top of the new stack memory
+ * @param stackSize: requested stack size (0 for the default); updated with
+ *                   the size of the stack actually reserved
  * @param entryPoint: function/address where the process will start executing
  * @param argc: argument count
  * @param argv: argument vector
  * @return: initial stack pointer (uint64_t) to use for the process
  */
-uint64_t setUpStackFrame(uint64_t *stackBase, uint64_t entryPoint, uint64_t argc, char **argv);
+uint64_t setUpStackFrame(uint64_t *stackBase, uint64_t *stackSize, uint64_t entryPoint, uint64_t argc, char **argv);
 
 /*
  * stackFrame (assembly helper)
@@ -0,0 +1,35 @@
+#ifndef STACK_POOL_H
+#define STACK_POOL_H
+
+#include <stdint.h>
+
+#define STACK_CLASS_COUNT 3 /* 4 KiB, 16 KiB and 64 KiB stacks */
+#define STACKS_PER_REFILL 4 /* stacks carved from each chunk taken from the heap */
+
+/*
+ * createStackPool
+ * Pre-carves a batch of default-sized stacks so the first spawns do not
+ * reach the memory manager.
+ */
+void createStackPool(void);
+
+/*
+ * allocStack
+ * Takes a stack of the smallest class holding `*size` bytes in O(1),
+ * refilling that class from the memory manager when it runs dry.
+ * @param size: requested size in bytes (0 selects PROCESS_STACK_SIZE);
+ *              updated with the size of the stack actually returned
+ * @return: lowest address of the stack, aligned to a 4 KiB page, or NULL
+ *          on failure
+ */
+void *allocStack(uint64_t *size);
+
+/*
+ * freeStack
+ * Returns a stack obtained with allocStack to its class in O(1).
+ * @param stack: lowest address of the stack
+ * @param size: size reported by allocStack
+ */
+void freeStack(void *stack, uint64_t size);
+
+#endif /* STACK_POOL_H */
@@ -16,6 +16,20 @@ void timer_handler();
  */
 int ticks_elapsed();
 
+/*
+ * current_tick
+ * Same as ticks_elapsed but leaves the interrupt flag alone, so it can be
+ * used from interrupt handlers and the scheduler.
+ * @return: number of timer ticks since boot
+ */
+uint64_t current_tick();
+
+/*
+ * timer_frequency
+ * @return: number of timer ticks per second
+ */
+uint16_t timer_frequency();
+
 /*
  * seconds_elapsed
  * @return: number of seconds elapsed since boot or since timer reset
@@ -24,14 +38,17 @@ int seconds_elapsed();
 
 /*
  * wait_ticks
- * Blocks or busy-waits until the specified number of ticks have elapsed.
+ * Blocks the calling process on the timer wheel until the specified number
+ * of ticks have elapsed. Processes that cannot block (idle) busy-wait.
+ * Must be called from syscall context: interrupts stay off until the
+ * dispatcher returns.
  * @param ticksToWait: number of timer ticks to wait
  */
 void wait_ticks(uint64_t ticksToWait);
 
 /*
  * wait_seconds
- * Blocks or busy-waits until the specified number of seconds have elapsed.
+ * Blocks until the specified number of seconds have elapsed (see wait_ticks).
  * @param secondsToWait: number of seconds to wait
  */
 void wait_seconds(uint64_t secondsToWait);
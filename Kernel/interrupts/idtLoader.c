@@ -24,10 +24,12 @@ void load_idt()
 {
 	_cli();
 	setup_IDT_entry(0x80, (uint64_t)&_irq80Handler);
+	setup_IDT_entry(0x81, (uint64_t)&_rescheduleHandler); // yield
 	setup_IDT_entry(0x21, (uint64_t)&_irq01Handler); // keyboard
 	setup_IDT_entry(0x20, (uint64_t)&_irq00Handler);
 	setup_IDT_entry(0x00, (uint64_t)&_exception0Handler);
 	setup_IDT_entry(0x06, (uint64_t)&_exception6Handler);
+	_setupSyscallMSRs(); // entrada rapida, int 80h queda por compatibilidad
 
 	// Solo interrupcion timer tick y keyboard habilitadas
 	picMasterMask(0xFC);
@@ -2,6 +2,7 @@
 #include <defs.h>
 #include <idtLoader.h>
 #include <interrupts.h>
+#include <kernelData.h>
 #include <keyboardDriver.h>
 #include <lib.h>
 #include <memoryManager.h>
@@ -84,11 +85,12 @@ int main()
 		printStr("Error initializing semaphore manager\n", RED);
 		return -1;
 	}
-	
+
+	initKernelData(timer_frequency());
 	startScheduler(idle);
 
 
-	createProcess("shell", (processFun)sampleCodeModuleAddress, 0, NULL, 0, 1, 0, 1);
+	createProcess("shell", (processFun)sampleCodeModuleAddress, 0, NULL, 0, 1, 0, 1, 0);
 	load_idt();
 	clear_buffer();
 	_sti();
@@ -1,3 +1,5 @@
+#include <lib.h>
+#include <memoryManager.h>
 #include <pipe.h>
 #include <semaphore.h>
 #include <stddef.h>
@@ -42,40 +44,86 @@ void createPipeManager() {
     pipes.next_pipe_id = 0;
     for(int i = 0; i < MAX_PIPES; i++) {
         pipes.pipes[i].isOpen = 0;
+        pipes.pipes[i].buffer = NULL;
+        pipes.pipes[i].size = 0;
         pipes.pipes[i].readIdx = 0;
         pipes.pipes[i].writeIdx = 0;
         pipes.pipes[i].count = 0;
         pipes.pipes[i].readers = 0;
         pipes.pipes[i].writers = 0;
+        pipes.pipes[i].readersWaiting = 0;
+        pipes.pipes[i].writersWaiting = 0;
+        pipes.pipes[i].spsc = 0;
+        pipes.pipes[i].head = 0;
+        pipes.pipes[i].tail = 0;
         pipes.pipes[i].semReaders = -1;
         pipes.pipes[i].semWriters = -1;
         pipes.pipes[i].mutex = -1;
     }
 }
 
-int createPipe() {
+/*
+ * pipeCapacity: rounds a requested size up to the power of two used as
+ * capacity, within [PIPE_MIN_SIZE, PIPE_MAX_SIZE]. Returns -1 if too big.
+ */
+static int pipeCapacity(int size) {
+    if (size == 0)
+        return PIPE_DEFAULT_SIZE;
+    if (size < 0 || size > PIPE_MAX_SIZE)
+        return -1;
+    int capacity = PIPE_MIN_SIZE;
+    while (capacity < size)
+        capacity <<= 1;
+    return capacity;
+}
+
+int createPipe(int size, int flags) {
     ensurePipeManagerInit();
-    
+    int capacity = pipeCapacity(size);
+    if (capacity < 0)
+        return -1;
+
     for(int i = 0; i < MAX_PIPES; i++) {
         if(!pipes.pipes[i].isOpen) {
             pipe_t *pipe = &pipes.pipes[i];
-            
+
+            pipe->buffer = allocMemory(capacity);
+            if (pipe->buffer == NULL)
+                return -1;
+            pipe->size = capacity;
             pipe->readIdx = 0;
             pipe->writeIdx = 0;
             pipe->count = 0;
             pipe->readers = 0;
             pipe->writers = 0;
-            pipe->isOpen = 1;
-            
+            pipe->readersWaiting = 0;
+            pipe->writersWaiting = 0;
+            pipe->spsc = (flags & PIPE_SPSC) != 0;
+            pipe->head = 0;
+            pipe->tail = 0;
+
             pipe->semReaders = next_sem_id++;
             pipe->semWriters = next_sem_id++;
             pipe->mutex = next_sem_id++;
-            
-            if(semInit(pipe->semReaders, 0) < 0 ||           
-               semInit(pipe->semWriters, PIPE_BUFFER_SIZE) < 0 || 
-               semInit(pipe->mutex, 1) < 0) {                    
+
+            /* on failure close only the semaphores opened here, then give the slot back */
+            int semIds[3] = {pipe->semReaders, pipe->semWriters, pipe->mutex};
+            uint32_t initialValues[3] = {0, 0, 1};
+            int opened = 0;
+            while (opened < 3 && semInit(semIds[opened], initialValues[opened]) == 0)
+                opened++;
+            if (opened < 3) {
+                while (opened > 0)
+                    semClose(semIds[--opened]);
+                freeMemory(pipe->buffer);
+                pipe->buffer = NULL;
+                pipe->size = 0;
+                pipe->semReaders = -1;
+                pipe->semWriters = -1;
+                pipe->mutex = -1;
                 return -1;
             }
+            pipe->isOpen = 1;
             if(i == 0) 
                 return 0;
             return i+2;
@@ -86,34 +134,130 @@ int createPipe() {
 
 
 
+/*
+ * wakeReaders / wakeWriters: called with the mutex held. Every sleeper is
+ * woken and re-checks the buffer; a post that lands before the sleeper
+ * reaches semWait is kept in the semaphore value, so no wake-up is lost.
+ */
+static void wakeReaders(pipe_t *pipe) {
+    while (pipe->readersWaiting > 0) {
+        pipe->readersWaiting--;
+        semPost(pipe->semReaders);
+    }
+}
+
+static void wakeWriters(pipe_t *pipe) {
+    while (pipe->writersWaiting > 0) {
+        pipe->writersWaiting--;
+        semPost(pipe->semWriters);
+    }
+}
+
+/*
+ * SPSC mode: the reader owns head and the writer owns tail. Each side
+ * publishes its index with a release store and reads the other's with an
+ * acquire load, so the bytes copied before a store are visible to whoever
+ * sees the new index. No mutex is taken; a side sleeps only when the ring
+ * is empty (reader) or full (writer).
+ *
+ * spscSleep: raises the waiting flag and sleeps unless `index` moved away
+ * from `seen` meanwhile. If it moved and the other side already took the
+ * flag, its post is absorbed so the semaphore does not keep a stale token.
+ */
+static void spscSleep(int *waiting, int sem, uint32_t *index, uint32_t seen) {
+    __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(index, __ATOMIC_SEQ_CST) == seen) {
+        semWait(sem);
+        return;
+    }
+    if (__atomic_exchange_n(waiting, 0, __ATOMIC_SEQ_CST) == 0)
+        semWait(sem);
+}
+
+/* spscWake: called after publishing an index; pairs with spscSleep */
+static void spscWake(int *waiting, int sem) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_exchange_n(waiting, 0, __ATOMIC_SEQ_CST))
+        semPost(sem);
+}
+
+static int spscRead(pipe_t *pipe, char *buffer, int size) {
+    uint32_t mask = pipe->size - 1;
+    uint32_t head = pipe->head;
+    uint32_t tail;
+    while ((tail = __atomic_load_n(&pipe->tail, __ATOMIC_ACQUIRE)) == head)
+        spscSleep(&pipe->readersWaiting, pipe->semReaders, &pipe->tail, tail);
+
+    uint32_t available = tail - head;
+    int toRead = (uint32_t)size < available ? size : (int)available;
+    int first = pipe->size - (head & mask);
+    if (first > toRead)
+        first = toRead;
+    memcpy(buffer, pipe->buffer + (head & mask), first);
+    memcpy(buffer + first, pipe->buffer, toRead - first);
+    __atomic_store_n(&pipe->head, head + toRead, __ATOMIC_RELEASE);
+
+    spscWake(&pipe->writersWaiting, pipe->semWriters);
+    return toRead;
+}
+
+static int spscWrite(pipe_t *pipe, const char *buffer, int size) {
+    uint32_t mask = pipe->size - 1;
+    uint32_t tail = pipe->tail;
+    int bytes_written = 0;
+    while (bytes_written < size) {
+        uint32_t head;
+        while (tail - (head = __atomic_load_n(&pipe->head, __ATOMIC_ACQUIRE)) == (uint32_t)pipe->size)
+            spscSleep(&pipe->writersWaiting, pipe->semWriters, &pipe->head, head);
+
+        int space = pipe->size - (tail - head);
+        int chunk = size - bytes_written < space ? size - bytes_written : space;
+        int first = pipe->size - (tail & mask);
+        if (first > chunk)
+            first = chunk;
+        memcpy(pipe->buffer + (tail & mask), buffer + bytes_written, first);
+        memcpy(pipe->buffer, buffer + bytes_written + first, chunk - first);
+        tail += chunk;
+        __atomic_store_n(&pipe->tail, tail, __ATOMIC_RELEASE);
+        bytes_written += chunk;
+
+        spscWake(&pipe->readersWaiting, pipe->semReaders);
+    }
+    return bytes_written;
+}
+
 int pipeRead(int pipe_id, char *buffer, int size) {
     ensurePipeManagerInit();
     PIPE_ID_CHECK(pipe_id)
     if(buffer == NULL || size <= 0)
         return -1;
     pipe_t *pipe = &pipes.pipes[pipe_id];
-    int bytes_read = 0;
-    /*
-     * Read loop: for each requested byte, wait for a reader-count token
-     * (blocks until data available), then grab the mutex, consume one
-     * byte from the circular buffer and release the mutex/writer token.
-     */
-    for (int i = 0; i < size; i++) {
-        semWait(pipe->semReaders);    /* wait until data available */
-        semWait(pipe->mutex);         /* enter critical section */
-
-        if (pipe->count > 0) {
-            buffer[i] = pipe->buffer[pipe->readIdx];
-            pipe->readIdx = (pipe->readIdx + 1) % PIPE_BUFFER_SIZE;
-            pipe->count--;
-            bytes_read++;
-        }
+    if (pipe->spsc)
+        return spscRead(pipe, buffer, size);
 
-        semPost(pipe->mutex);        /* leave critical section */
-        semPost(pipe->semWriters);   /* signal writers there is space */
+    semWait(pipe->mutex);
+    while (pipe->count == 0) {
+        /* sleep until a writer posts, without holding the mutex */
+        pipe->readersWaiting++;
+        semPost(pipe->mutex);
+        semWait(pipe->semReaders);
+        semWait(pipe->mutex);
     }
 
-    return bytes_read;
+    /* copy everything available, in at most two pieces across the wrap */
+    int toRead = size < pipe->count ? size : pipe->count;
+    int first = pipe->size - pipe->readIdx;
+    if (first > toRead)
+        first = toRead;
+    memcpy(buffer, pipe->buffer + pipe->readIdx, first);
+    memcpy(buffer + first, pipe->buffer, toRead - first);
+    pipe->readIdx = (pipe->readIdx + toRead) & (pipe->size - 1);
+    pipe->count -= toRead;
+
+    wakeWriters(pipe);
+    semPost(pipe->mutex);
+
+    return toRead;
 }
 
 int pipeWrite(int pipe_id, const char *buffer, int size) {
@@ -123,26 +267,78 @@ int pipeWrite(int pipe_id, const char *buffer, int size) {
     if(buffer == NULL || size <= 0)
         return -1;
     pipe_t *pipe = &pipes.pipes[pipe_id];
+    if (pipe->spsc)
+        return spscWrite(pipe, buffer, size);
     int bytes_written = 0;
-    
-    for(int i = 0; i < size; i++) {
-        semWait(pipe->semWriters); 
-        semWait(pipe->mutex);           
-        
-        if(pipe->count < PIPE_BUFFER_SIZE) {
-            pipe->buffer[pipe->writeIdx] = buffer[i];
-            pipe->writeIdx = (pipe->writeIdx + 1) % PIPE_BUFFER_SIZE;
-            pipe->count++;
-            bytes_written++;
+
+    semWait(pipe->mutex);
+    while (bytes_written < size) {
+        while (pipe->count == pipe->size) {
+            pipe->writersWaiting++;
+            semPost(pipe->mutex);
+            semWait(pipe->semWriters);
+            semWait(pipe->mutex);
         }
 
-        semPost(pipe->mutex);
-        semPost(pipe->semReaders);
+        int space = pipe->size - pipe->count;
+        int chunk = size - bytes_written < space ? size - bytes_written : space;
+        int first = pipe->size - pipe->writeIdx;
+        if (first > chunk)
+            first = chunk;
+        memcpy(pipe->buffer + pipe->writeIdx, buffer + bytes_written, first);
+        memcpy(pipe->buffer, buffer + bytes_written + first, chunk - first);
+        pipe->writeIdx = (pipe->writeIdx + chunk) & (pipe->size - 1);
+        pipe->count += chunk;
+        bytes_written += chunk;
+
+        /* wake the reader once per chunk so it can drain while we wait */
+        wakeReaders(pipe);
     }
+    semPost(pipe->mutex);
 
     return bytes_written;
 }
 
+int pipeResize(int pipe_id, int size) {
+    ensurePipeManagerInit();
+    PIPE_ID_CHECK(pipe_id)
+    int capacity = pipeCapacity(size);
+    if (capacity < 0)
+        return -1;
+    pipe_t *pipe = &pipes.pipes[pipe_id];
+    /* without the mutex the buffer cannot be swapped under a running side */
+    if (pipe->spsc)
+        return -1;
+
+    semWait(pipe->mutex);
+    if (capacity == pipe->size) {
+        semPost(pipe->mutex);
+        return capacity;
+    }
+    char *buffer;
+    if (capacity < pipe->count || (buffer = allocMemory(capacity)) == NULL) {
+        semPost(pipe->mutex);
+        return -1;
+    }
+
+    /* unwrap the buffered data to the start of the new buffer */
+    int first = pipe->size - pipe->readIdx;
+    if (first > pipe->count)
+        first = pipe->count;
+    memcpy(buffer, pipe->buffer + pipe->readIdx, first);
+    memcpy(buffer + first, pipe->buffer, pipe->count - first);
+    freeMemory(pipe->buffer);
+    pipe->buffer = buffer;
+    pipe->size = capacity;
+    pipe->readIdx = 0;
+    pipe->writeIdx = pipe->count & (capacity - 1);
+
+    wakeWriters(pipe);
+    semPost(pipe->mutex);
+
+    return capacity;
+}
+
 int pipeClose(int pipe_id) {
     ensurePipeManagerInit();
     PIPE_ID_CHECK(pipe_id)
@@ -158,12 +354,20 @@ int pipeClose(int pipe_id) {
     semClose(pipe->mutex);
 
     /* clear and mark as closed */
+    freeMemory(pipe->buffer);
+    pipe->buffer = NULL;
+    pipe->size = 0;
     pipe->isOpen = 0;
     pipe->readIdx = 0;
     pipe->writeIdx = 0;
     pipe->count = 0;
     pipe->readers = 0;
     pipe->writers = 0;
+    pipe->readersWaiting = 0;
+    pipe->writersWaiting = 0;
+    pipe->spsc = 0;
+    pipe->head = 0;
+    pipe->tail = 0;
     pipe->semReaders = -1;
     pipe->semWriters = -1;
     pipe->mutex = -1;
@@ -175,12 +379,19 @@ int pipeClear(int pipe_id){
     ensurePipeManagerInit();
     PIPE_ID_CHECK(pipe_id)
     pipe_t *pipe = &pipes.pipes[pipe_id];
+    if (pipe->spsc) {
+        /* the reader drops everything written so far */
+        __atomic_store_n(&pipe->head, __atomic_load_n(&pipe->tail, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+        spscWake(&pipe->writersWaiting, pipe->semWriters);
+        return 0;
+    }
     /* clear contents of the circular buffer under mutex */
     semWait(pipe->mutex);
 
     pipe->readIdx = 0;
     pipe->writeIdx = 0;
     pipe->count = 0;
+    wakeWriters(pipe);
 
     semPost(pipe->mutex);
 
@@ -5,18 +5,33 @@
 #include "../include/memoryManager.h"
 #include "../include/scheduler.h"
 #include <lib.h>
-#include <queue.h>
+#include <pcbQueue.h>
 #include <stddef.h>
 #include <string.h>
+#include <time.h>
+
+#define PROCESS_TABLE_MASK (PROCESS_TABLE_SIZE - 1)
+#define PRIORITY_LEVELS (MAX_PRIORITY - MIN_PRIORITY + 1)
+#define AGING_INTERVAL 16 /* scheduling decisions between aging passes */
+#define TIMER_WHEEL_SLOTS 64 /* power of two */
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
 
 typedef struct ProcessManagerCDT {
 	PCB *foregroundProcess;
 	PCB *currentProcess;
-	QueueADT readyQueue;
-	QueueADT blockedQueue;
-	QueueADT blockedQueueBySem;
-	QueueADT zombieQueue;
+	/* one ready queue per priority, MIN_PRIORITY (most urgent) first */
+	PCBQueue readyQueues[PRIORITY_LEVELS];
+	uint32_t readyLevels; /* bit i set if readyQueues[i] is not empty */
+	uint32_t picksSinceAging;
+	PCBQueue blockedQueue;
+	PCBQueue blockedQueueBySem;
+	PCBQueue zombieQueue;
+	/* sleeping processes, hashed by wake-up tick */
+	PCBQueue timerWheel[TIMER_WHEEL_SLOTS];
 	PCB *idleProcess;
+	/* every live PCB, open addressing on pid with linear probing */
+	PCB *processTable[PROCESS_TABLE_SIZE];
+	uint64_t processTableCount;
 	uint8_t lock; // Global lock for process manager operations
 } ProcessManagerCDT;
 
@@ -32,51 +47,161 @@ ProcessManagerADT createProcessManager()
 	processManager->foregroundProcess = NULL;
 	processManager->currentProcess = NULL;
 	processManager->lock = 0;
-	processManager->readyQueue = createQueue();
-	if (processManager->readyQueue == NULL) {
-		freeMemory(processManager);
-		return NULL;
+	processManager->processTableCount = 0;
+	for (int i = 0; i < PROCESS_TABLE_SIZE; i++) {
+		processManager->processTable[i] = NULL;
 	}
-	processManager->blockedQueue = createQueue();
-	if (processManager->blockedQueue == NULL) {
-		freeQueue(processManager->readyQueue);
-		freeMemory(processManager);
-		return NULL;
+	for (int i = 0; i < PRIORITY_LEVELS; i++) {
+		initPCBQueue(&processManager->readyQueues[i]);
 	}
-	processManager->blockedQueueBySem = createQueue();
-	if (processManager->blockedQueueBySem == NULL) {
-		freeQueue(processManager->readyQueue);
-		freeQueue(processManager->blockedQueue);
-		freeMemory(processManager);
-		return NULL;
+	processManager->readyLevels = 0;
+	processManager->picksSinceAging = 0;
+	initPCBQueue(&processManager->blockedQueue);
+	initPCBQueue(&processManager->blockedQueueBySem);
+	initPCBQueue(&processManager->zombieQueue);
+	for (int i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+		initPCBQueue(&processManager->timerWheel[i]);
+	}
+	return processManager;
+}
+
+/*
+ * findSlot (static)
+ * @return: slot holding `pid`, or the empty slot where the probe stopped
+ */
+static uint64_t findSlot(ProcessManagerADT pm, pid_t pid)
+{
+	uint64_t slot = (uint64_t)pid & PROCESS_TABLE_MASK;
+	while (pm->processTable[slot] != NULL && pm->processTable[slot]->pid != pid) {
+		slot = (slot + 1) & PROCESS_TABLE_MASK;
 	}
-	processManager->zombieQueue = createQueue();
-	if (processManager->zombieQueue == NULL) {
-		freeQueue(processManager->readyQueue);
-		freeQueue(processManager->blockedQueue);
-		freeQueue(processManager->zombieQueue);
-		freeMemory(processManager);
+	return slot;
+}
+
+int registerProcess(ProcessManagerADT pm, PCB *process)
+{
+	/* keep one slot empty so every probe terminates */
+	if (pm == NULL || process == NULL || pm->processTableCount >= PROCESS_TABLE_SIZE - 1) {
+		return -1;
+	}
+	uint64_t slot = findSlot(pm, process->pid);
+	if (pm->processTable[slot] != NULL) {
+		return -1;
+	}
+	pm->processTable[slot] = process;
+	pm->processTableCount++;
+	return 0;
+}
+
+void unregisterProcess(ProcessManagerADT pm, pid_t pid)
+{
+	if (pm == NULL) {
+		return;
+	}
+	uint64_t slot = findSlot(pm, pid);
+	if (pm->processTable[slot] == NULL) {
+		return;
+	}
+	pm->processTable[slot] = NULL;
+	pm->processTableCount--;
+
+	/* backward-shift deletion: pull later entries of the probe run into the hole */
+	uint64_t hole = slot;
+	uint64_t next = (slot + 1) & PROCESS_TABLE_MASK;
+	while (pm->processTable[next] != NULL) {
+		uint64_t home = (uint64_t)pm->processTable[next]->pid & PROCESS_TABLE_MASK;
+		/* move the entry unless its home lies cyclically in (hole, next] */
+		if (((next - home) & PROCESS_TABLE_MASK) >= ((next - hole) & PROCESS_TABLE_MASK)) {
+			pm->processTable[hole] = pm->processTable[next];
+			pm->processTable[next] = NULL;
+			hole = next;
+		}
+		next = (next + 1) & PROCESS_TABLE_MASK;
+	}
+}
+
+PCB *nextProcessInTable(ProcessManagerADT pm, uint64_t *cursor)
+{
+	if (pm == NULL || cursor == NULL) {
 		return NULL;
 	}
-	return processManager;
+	while (*cursor < PROCESS_TABLE_SIZE) {
+		PCB *process = pm->processTable[(*cursor)++];
+		if (process != NULL) {
+			return process;
+		}
+	}
+	return NULL;
 }
 
-int compareByPid(void *a, void *b)
+/*
+ * baseLevel (static)
+ * @return: ready queue index matching the priority of `process`
+ */
+static int baseLevel(PCB *process)
 {
-	PCB *pcbA = (PCB *)a;
-	PCB *pcbB = (PCB *)b;
-	return (pcbA->pid == pcbB->pid) ? 0 : -1;
+	int8_t priority = process->priority;
+	if (priority < MIN_PRIORITY) {
+		priority = MIN_PRIORITY;
+	} else if (priority > MAX_PRIORITY) {
+		priority = MAX_PRIORITY;
+	}
+	return priority - MIN_PRIORITY;
 }
 
-int hasPid(void *a, void *b)
+static int isReady(ProcessManagerADT pm, PCB *process)
 {
-	if (a == NULL || b == NULL) {
+	PCBQueue *queue = process->queue;
+	return queue >= &pm->readyQueues[0] && queue < &pm->readyQueues[PRIORITY_LEVELS];
+}
+
+static void pushReady(ProcessManagerADT pm, PCB *process, int level)
+{
+	pushPCB(&pm->readyQueues[level], process);
+	pm->readyLevels |= 1U << level;
+}
+
+/*
+ * removeReady (static)
+ * Unlinks `process` from whichever ready queue holds it.
+ * @return: 0 on success, -1 if the process is not ready
+ */
+static int removeReady(ProcessManagerADT pm, PCB *process)
+{
+	if (process == NULL || !isReady(pm, process)) {
 		return -1;
 	}
-	PCB *processA = (PCB *)a;
-	pid_t *pid = (pid_t *)b;
+	PCBQueue *queue = process->queue;
+	removePCB(queue, process);
+	if (isPCBQueueEmpty(queue)) {
+		pm->readyLevels &= ~(1U << (queue - pm->readyQueues));
+	}
+	return 0;
+}
+
+/*
+ * ageReadyQueues (static)
+ * Moves the longest-waiting process of every non-empty level one level up,
+ * so low-priority work cannot starve. The boost lasts until the process is
+ * picked, which puts it back at its own level.
+ */
+static void ageReadyQueues(ProcessManagerADT pm)
+{
+	for (int level = 1; level < PRIORITY_LEVELS; level++) {
+		PCB *process = peekPCB(&pm->readyQueues[level]);
+		if (process != NULL) {
+			removeReady(pm, process);
+			pushReady(pm, process, level - 1);
+		}
+	}
+}
 
-	return (processA->pid == *pid) ? 0 : -1;
+void updateReadyPriority(ProcessManagerADT pm, PCB *process)
+{
+	if (pm == NULL || removeReady(pm, process) != 0) {
+		return;
+	}
+	pushReady(pm, process, baseLevel(process));
 }
 
 void addProcess(ProcessManagerADT pm, PCB *process)
@@ -88,7 +213,7 @@ void addProcess(ProcessManagerADT pm, PCB *process)
 	if (pm->currentProcess == NULL || pm->currentProcess == pm->idleProcess) {
 		pm->currentProcess = process;
 	}
-	enqueue(pm->readyQueue, process);
+	pushReady(pm, process, baseLevel(process));
 }
 
 void removeFromReady(ProcessManagerADT pm, pid_t pid)
@@ -97,7 +222,7 @@ void removeFromReady(ProcessManagerADT pm, pid_t pid)
 		return;
 	}
 
-	remove(pm->readyQueue, &pid, hasPid);
+	removeReady(pm, getProcess(pm, pid));
 	if (pm->foregroundProcess && pm->foregroundProcess->pid == pid) {
 		pm->foregroundProcess = NULL;
 	}
@@ -109,20 +234,8 @@ void removeFromZombie(ProcessManagerADT pm, pid_t pid)
 		return;
 	}
 
-	remove(pm->zombieQueue, &pid, hasPid);
-}
-
-static PCB *switchProcessFromQueues(QueueADT queueFrom, QueueADT queueTo, pid_t pid)
-{
-	if (queueFrom == NULL || queueTo == NULL) {
-		return NULL;
-	}
-	PCB *process = (PCB *)remove(queueFrom, &pid, hasPid);
-	if (process == NULL) {
-		return NULL;
-	}
-	enqueue(queueTo, process);
-	return process;
+	removePCB(&pm->zombieQueue, getProcess(pm, pid));
+	unregisterProcess(pm, pid);
 }
 
 int blockProcessQueue(ProcessManagerADT pm, pid_t pid)
@@ -131,55 +244,84 @@ int blockProcessQueue(ProcessManagerADT pm, pid_t pid)
 		return -1;
 	}
 	
-	// Don't allow blocking processes that are already blocked by semaphores
-	// This would break the semaphore's ability to unblock them
-	PCB *semBlockedProcess = (PCB *)containsQueue(pm->blockedQueueBySem, &pid, hasPid);
-	if (semBlockedProcess != NULL) {
-		// Process is blocked by semaphore - cannot manually block it
+	// Only ready processes can be blocked: processes blocked by a semaphore
+	// must stay where the semaphore can unblock them
+	PCB *process = getProcess(pm, pid);
+	if (removeReady(pm, process) != 0) {
 		return -1;
 	}
+	pushPCB(&pm->blockedQueue, process);
+
+	setProcessState(process, BLOCKED);
 	
-	QueueADT queue = pm->readyQueue;
-	PCB *process = (PCB *)containsQueue(pm->readyQueue, &pid, hasPid);
-	if (process == NULL) {
-		// Check if already in blocked queue
-		process = (PCB *)containsQueue(pm->blockedQueue, &pid, hasPid);
-		if (process != NULL) {
-			// Already blocked
-			return -1;
-		}
+	return 0;
+}
+
+int blockProcessQueueBySem(ProcessManagerADT pm, pid_t pid)
+{
+	if (pm == NULL) {
 		return -1;
 	}
 
-	process = switchProcessFromQueues(queue, pm->blockedQueue, pid);
-	if (process == NULL) {
+	PCB *process = getProcess(pm, pid);
+	if (removeReady(pm, process) != 0) {
 		return -1;
 	}
+	pushPCB(&pm->blockedQueueBySem, process);
 
-	/* ensure state is BLOCKED */
-	if (process->state != BLOCKED) {
-		process->state = BLOCKED;
-	}
+	setProcessState(process, BLOCKED);
 	
 	return 0;
 }
 
-int blockProcessQueueBySem(ProcessManagerADT pm, pid_t pid)
+void setProcessState(PCB *process, State state)
+{
+	/* running time is charged tick by tick, waiting time on each change */
+	uint64_t now = current_tick();
+	uint64_t elapsed = now - process->cpu.stateSince;
+	if (process->state == READY) {
+		process->cpu.readyTicks += elapsed;
+	} else if (process->state == BLOCKED) {
+		process->cpu.blockedTicks += elapsed;
+	}
+	process->state = state;
+	process->cpu.stateSince = now;
+}
+
+int sleepProcessQueue(ProcessManagerADT pm, pid_t pid, uint64_t wakeTick)
 {
 	if (pm == NULL) {
 		return -1;
 	}
 
-	PCB *process = switchProcessFromQueues(pm->readyQueue, pm->blockedQueueBySem, pid);
-	if (process == NULL) {
+	PCB *process = getProcess(pm, pid);
+	if (removeReady(pm, process) != 0) {
 		return -1;
 	}
+	process->wakeTick = wakeTick;
+	setProcessState(process, BLOCKED);
+	pushPCB(&pm->timerWheel[wakeTick & TIMER_WHEEL_MASK], process);
+	return 0;
+}
 
-	if (process->state != BLOCKED) {
-		process->state = BLOCKED;
+void wakeSleepingProcesses(ProcessManagerADT pm, uint64_t now)
+{
+	if (pm == NULL) {
+		return;
+	}
+
+	/* only this tick's slot can hold due sleepers; later rounds stay put */
+	PCBQueue *slot = &pm->timerWheel[now & TIMER_WHEEL_MASK];
+	uint64_t pending = slot->size;
+	while (pending-- > 0) {
+		PCB *process = popPCB(slot);
+		if (process->wakeTick <= now) {
+			setProcessState(process, READY);
+			pushReady(pm, process, baseLevel(process));
+		} else {
+			pushPCB(slot, process);
+		}
 	}
-	
-	return 0;
 }
 
 int unblockProcessQueue(ProcessManagerADT pm, pid_t pid)
@@ -188,14 +330,13 @@ int unblockProcessQueue(ProcessManagerADT pm, pid_t pid)
 		return -1;
 	}
 
-	PCB *process = switchProcessFromQueues(pm->blockedQueue, pm->readyQueue, pid);
-	if (process == NULL) {
+	PCB *process = getProcess(pm, pid);
+	if (removePCB(&pm->blockedQueue, process) != 0) {
 		return -1;
 	}
+	pushReady(pm, process, baseLevel(process));
 
-	if (process->state != READY) {
-		process->state = READY;
-	}
+	setProcessState(process, READY);
 	
 	return 0;
 }
@@ -206,14 +347,13 @@ int unblockProcessQueueBySem(ProcessManagerADT pm, pid_t pid)
 		return -1;
 	}
 
-	PCB *process = switchProcessFromQueues(pm->blockedQueueBySem, pm->readyQueue, pid);
-	if (process == NULL) {
+	PCB *process = getProcess(pm, pid);
+	if (removePCB(&pm->blockedQueueBySem, process) != 0) {
 		return -1;
 	}
+	pushReady(pm, process, baseLevel(process));
 
-	if (process->state != READY) {
-		process->state = READY;
-	}
+	setProcessState(process, READY);
 	
 	return 0;
 }
@@ -223,10 +363,6 @@ void freeProcessLinkedLists(ProcessManagerADT pm)
 	if (pm == NULL) {
 		return;
 	}
-	freeQueue(pm->readyQueue);
-	freeQueue(pm->blockedQueue);
-	freeQueue(pm->blockedQueueBySem);
-	freeQueue(pm->zombieQueue);
 	freeMemory(pm);
 }
 
@@ -236,89 +372,64 @@ PCB *getProcess(ProcessManagerADT pm, pid_t pid)
 		return NULL;
 	}
 
-	PCB *process = (PCB *)containsQueue(pm->readyQueue, &pid, hasPid);
-	if (process != NULL) {
-		return process;
-	}
-
-	process = (PCB *)containsQueue(pm->blockedQueue, &pid, hasPid);
-	if (process != NULL) {
-		return process;
-	}
-
-	process = (PCB *)containsQueue(pm->blockedQueueBySem, &pid, hasPid);
-	if (process != NULL) {
-		return process;
-	}
+	return pm->processTable[findSlot(pm, pid)];
+}
 
-	process = (PCB *)containsQueue(pm->zombieQueue, &pid, hasPid);
-	if (process != NULL) {
-		return process;
-	}
+PCB *getNextReadyProcess(ProcessManagerADT pm)
+{
+	return getNextProcess(pm);
+}
 
-	if (pm->currentProcess != NULL && pm->currentProcess->pid == pid) {
-		return pm->currentProcess;
-	}
+static PCB *switchToReady(ProcessManagerADT pm, PCB *process)
+{
+	removeReady(pm, process);
+	pushReady(pm, process, baseLevel(process));
 
-	if (pm->idleProcess != NULL && pm->idleProcess->pid == pid) {
-		return pm->idleProcess;
+	pm->currentProcess = process;
+	if (isForegroundProcess(process)) {
+		foregroundProcessSet(pm, process);
 	}
-
-	return NULL;
+	return process;
 }
 
-PCB *getNextReadyProcess(ProcessManagerADT pm)
+PCB *getNextProcess(ProcessManagerADT pm)
 {
 	if (pm == NULL) {
 		return NULL;
 	}
 
-	if (isQueueEmpty(pm->readyQueue)) {
+	if (pm->readyLevels == 0) {
 		pm->currentProcess = pm->idleProcess;
 		return pm->idleProcess;
 	}
 
-	PCB *nextProcess = (PCB *)dequeue(pm->readyQueue);
-	if (nextProcess == NULL) {
-		return NULL;
-	}
-
-	if (enqueue(pm->readyQueue, nextProcess) != 0) {
-		return NULL;
+	if (++pm->picksSinceAging >= AGING_INTERVAL) {
+		pm->picksSinceAging = 0;
+		ageReadyQueues(pm);
 	}
 
-	pm->currentProcess = nextProcess;
-	if (isForegroundProcess(nextProcess)) {
-		foregroundProcessSet(pm, nextProcess);
-	}
-	return nextProcess;
+	/* head of the most urgent non-empty level, requeued at its own level */
+	int level = __builtin_ctz(pm->readyLevels);
+	return switchToReady(pm, peekPCB(&pm->readyQueues[level]));
 }
 
-PCB *getNextProcess(ProcessManagerADT pm)
+PCB *takeReadyProcess(ProcessManagerADT pm, pid_t pid)
 {
 	if (pm == NULL) {
 		return NULL;
 	}
 
-	if (isQueueEmpty(pm->readyQueue)) {
-		pm->currentProcess = pm->idleProcess;
-		return pm->idleProcess;
-	}
-
-	PCB *nextProcess = (PCB *)dequeue(pm->readyQueue);
-	if (nextProcess == NULL) {
+	PCB *process = getProcess(pm, pid);
+	if (process == NULL || process->state != READY || !isReady(pm, process)) {
 		return NULL;
 	}
-
-	if (enqueue(pm->readyQueue, nextProcess) != 0) {
+	/* a strictly more urgent ready level goes first; `pid` stays queued */
+	PCBQueue *queue = process->queue;
+	int level = queue - pm->readyQueues;
+	if (__builtin_ctz(pm->readyLevels) < level) {
 		return NULL;
 	}
-
-	pm->currentProcess = nextProcess;
-	if (isForegroundProcess(nextProcess)) {
-		foregroundProcessSet(pm, nextProcess);
-	}
-	return nextProcess;
+	return switchToReady(pm, process);
 }
 
 int hasNextReadyProcess(ProcessManagerADT pm)
@@ -327,7 +438,7 @@ int hasNextReadyProcess(ProcessManagerADT pm)
 		return 0;
 	}
 
-	return !isQueueEmpty(pm->readyQueue);
+	return pm->readyLevels != 0;
 }
 
 PCB *getCurrentProcess(ProcessManagerADT pm)
@@ -371,14 +482,7 @@ uint64_t processCount(ProcessManagerADT pm)
 		return 0;
 	}
 
-	uint64_t count = 0;
-	count += queueSize(pm->readyQueue);
-	count += queueSize(pm->blockedQueue);
-	count += queueSize(pm->blockedQueueBySem);
-	count += queueSize(pm->zombieQueue);
-	count++;
-
-	return count;
+	return pm->processTableCount;
 }
 
 uint64_t readyProcessCount(ProcessManagerADT pm)
@@ -387,7 +491,11 @@ uint64_t readyProcessCount(ProcessManagerADT pm)
 		return 0;
 	}
 
-	return queueSize(pm->readyQueue);
+	uint64_t count = 0;
+	for (int i = 0; i < PRIORITY_LEVELS; i++) {
+		count += pm->readyQueues[i].size;
+	}
+	return count;
 }
 
 uint64_t blockedProcessCount(ProcessManagerADT pm)
@@ -396,7 +504,7 @@ uint64_t blockedProcessCount(ProcessManagerADT pm)
 		return 0;
 	}
 
-	return queueSize(pm->blockedQueue) + queueSize(pm->blockedQueueBySem);
+	return pm->blockedQueue.size + pm->blockedQueueBySem.size;
 }
 
 uint64_t zombieProcessCount(ProcessManagerADT pm)
@@ -405,7 +513,7 @@ uint64_t zombieProcessCount(ProcessManagerADT pm)
 		return 0;
 	}
 
-	return queueSize(pm->zombieQueue);
+	return pm->zombieQueue.size;
 }
 
 PCB *getForegroundProcess(ProcessManagerADT pm)
@@ -441,23 +549,22 @@ PCB *killProcess(ProcessManagerADT pm, pid_t pid, uint64_t ret, State state)
 	if (pm->currentProcess && pm->currentProcess->pid == pid) {
 		pm->currentProcess = pm->idleProcess;
 	}
-	PCB *process = switchProcessFromQueues(pm->readyQueue, pm->zombieQueue, pid);
-	if (process == NULL) {
-		process = switchProcessFromQueues(pm->blockedQueue, pm->zombieQueue, pid);
-		if (process == NULL) {
-			process = switchProcessFromQueues(pm->blockedQueueBySem, pm->zombieQueue, pid);
-			if (process == NULL) {
-				return NULL;
-			}
-		}
+	PCB *process = getProcess(pm, pid);
+	if (process == NULL || process->queue == NULL || process->queue == &pm->zombieQueue) {
+		return NULL;
 	}
+	/* ready, blocked, blocked on a semaphore or asleep */
+	if (removeReady(pm, process) != 0) {
+		removePCB(process->queue, process);
+	}
+	pushPCB(&pm->zombieQueue, process);
 
 	if (pm->foregroundProcess && pm->foregroundProcess->pid == pid) {
 		pm->foregroundProcess = NULL;
 	}
 
 	process->retValue = ret;
-	process->state = state;
+	setProcessState(process, state);
 	return process;
 }
 
@@ -484,7 +591,7 @@ void addToReady(ProcessManagerADT pm, PCB *process)
 	if (pm == NULL || process == NULL) {
 		return;
 	}
-	enqueue(pm->readyQueue, process);
+	pushReady(pm, process, baseLevel(process));
 }
 
 void addToBlocked(ProcessManagerADT pm, PCB *process)
@@ -492,7 +599,7 @@ void addToBlocked(ProcessManagerADT pm, PCB *process)
 	if (pm == NULL || process == NULL) {
 		return;
 	}
-	enqueue(pm->blockedQueue, process);
+	pushPCB(&pm->blockedQueue, process);
 }
 
 void addToBlockedBySem(ProcessManagerADT pm, PCB *process)
@@ -500,5 +607,5 @@ void addToBlockedBySem(ProcessManagerADT pm, PCB *process)
 	if (pm == NULL || process == NULL) {
 		return;
 	}
-	enqueue(pm->blockedQueueBySem, process);
+	pushPCB(&pm->blockedQueueBySem, process);
 }
\ No newline at end of file
@@ -1,22 +1,35 @@
 #include "../../Shared/shared_structs.h"
+#include <arena.h>
 #include <defs.h>
 #include <interrupts.h>
+#include <kernelData.h>
 #include <lib.h>
 #include <memoryManager.h>
 #include <pipe.h>
 #include <scheduler.h>
 #include <semaphore.h>
+#include <slab.h>
 #include <stackFrame.h>
+#include <stackPool.h>
 #include <syscall.h>
 #include <textModule.h>
+#include <time.h>
 
 #define SHELL_PID 1
 #define TTY 0
 
 #define QUANTUM 3
-#define MAX_PRIORITY 5
-#define MIN_PRIORITY 0
-#define IDLE_PRIORITY 6
+
+/* load average, sampled every 5 seconds like the classic Unix one */
+#define LOAD_SAMPLE_SECONDS 5
+#define EXP_1 1884  /* LOAD_FIXED_1 / exp(5s / 1min) */
+#define EXP_5 2014  /* LOAD_FIXED_1 / exp(5s / 5min) */
+#define EXP_15 2037 /* LOAD_FIXED_1 / exp(5s / 15min) */
+
+/* switch to a process woken by a semaphore if it is at least as urgent */
+#ifndef WAKEUP_PREEMPTION
+#define WAKEUP_PREEMPTION 1
+#endif
 
 uint64_t calculateQuantum(int8_t priority)
 {
@@ -30,9 +43,16 @@ static ProcessManagerADT processManager = NULL;
 static pid_t currentPid = -1;
 static pid_t nextPid = 0;
 static uint64_t quantum = 0;
+static pid_t handoffPid = -1;
+static int handingOff = 0;
+static uint64_t donatedQuantum = 0;
+static int voluntarySwitch = 0;
+static uint64_t contextSwitches = 0;
+static uint64_t loadAverage[3] = {0, 0, 0};
+static kmem_cache_t *pcbCache = NULL;
 
 static PCB *createProcessOnPCB(char *name, processFun function, uint64_t argc, char **arg, uint8_t priority,
-                               char foreground, int stdin, int stdout);
+                               char foreground, int stdin, int stdout, uint64_t stackSize);
 static void wakeUpWaitingParent(pid_t parentPid, pid_t childPid);
 int getCurrentStdin();
 int getCurrentStdout();
@@ -41,17 +61,18 @@ static int32_t reapCild(PCB *child, int32_t *retValue);
 void startScheduler(processFun idle)
 {
 	createPipeManager();
+	pcbCache = kmem_cache_create("pcb", sizeof(PCB));
+	createStackPool();
 
-	ProcessManagerADT list = createProcessManager();
-	PCB *idleProcess = createProcessOnPCB("idle", idle, 0, NULL, IDLE_PRIORITY, 0, -1, -1);
-	setIdleProcess(list, idleProcess);
-	processManager = list;
+	processManager = createProcessManager();
+	PCB *idleProcess = createProcessOnPCB("idle", idle, 0, NULL, IDLE_PRIORITY, 0, -1, -1, 0);
+	setIdleProcess(processManager, idleProcess);
 }
 
 pid_t createProcess(char *name, processFun function, uint64_t argc, char **arg, uint8_t priority, char foreground,
-                    int stdin, int stdout)
+                    int stdin, int stdout, uint64_t stackSize)
 {
-	PCB *process = createProcessOnPCB(name, function, argc, arg, priority, foreground, stdin, stdout);
+	PCB *process = createProcessOnPCB(name, function, argc, arg, priority, foreground, stdin, stdout, stackSize);
 	if (process == NULL) {
 		return -1;
 	}
@@ -59,13 +80,13 @@ pid_t createProcess(char *name, processFun function, uint64_t argc, char **arg,
 }
 
 static PCB *createProcessOnPCB(char *name, processFun function, uint64_t argc, char **arg, uint8_t priority,
-                               char foreground, int stdin, int stdout)
+                               char foreground, int stdin, int stdout, uint64_t stackSize)
 {
 	if (name == NULL || function == NULL || (argc > 0 && arg == NULL)) {
 		return NULL;
 	}
 
-	PCB *process = allocMemory(sizeof(PCB));
+	PCB *process = kmem_cache_alloc(pcbCache);
 	if (process == NULL) {
 		return NULL;
 	}
@@ -82,23 +103,35 @@ static PCB *createProcessOnPCB(char *name, processFun function, uint64_t argc, c
 	process->stdin = -1;
 	process->stdout = -1;
 	process->state = READY;
+	memset(&process->cpu, 0, sizeof(CpuStats));
+	process->cpu.stateSince = current_tick();
 	process->priority = priority;
 	process->parentPid = getCurrentPid();
 	process->children_sem = -1;
 	process->children_count = 0;
+	initArena(process);
+	process->queue = NULL;
+	process->ioRing = NULL;
+	process->heapBase = NULL;
 
 	process->entryPoint = (uint64_t)function;
 
-	process->rsp = setUpStackFrame(&process->base, (uint64_t)function, argc, arg);
+	process->stackSize = stackSize;
+	process->rsp = setUpStackFrame(&process->base, &process->stackSize, (uint64_t)function, argc, arg);
 	if (process->rsp == 0) {
-		freeMemory(process);
+		kmem_cache_free(pcbCache, process);
+		return NULL;
+	}
+	if (registerProcess(processManager, process) != 0) {
+		freeStack((void*)(process->base - process->stackSize), process->stackSize);
+		kmem_cache_free(pcbCache, process);
 		return NULL;
 	}
 
 	if (process->pid > 1) {
 		if (!foreground && stdin == TTY) {
 			process->stdout = stdout;
-			process->state = BLOCKED;
+			setProcessState(process, BLOCKED);
 			addToBlocked(processManager, process);
 			return process;
 		}
@@ -126,10 +159,11 @@ static PCB *createProcessOnPCB(char *name, processFun function, uint64_t argc, c
 		}
 
 	} else if (process->pid == SHELL_PID) {
-		process->stdin = createPipe();
+		process->stdin = createPipe(PIPE_DEFAULT_SIZE, 0);
         if (process->stdin < 0) {
-            freeMemory((void*)process->base - PROCESS_STACK_SIZE);
-            freeMemory(process);
+            unregisterProcess(processManager, process->pid);
+            freeStack((void*)(process->base - process->stackSize), process->stackSize);
+            kmem_cache_free(pcbCache, process);
             return NULL;
         }
         process->stdout = 1;
@@ -152,6 +186,11 @@ pid_t getCurrentPid()
 	return current ? current->pid : -1;
 }
 
+PCB *getCurrentPCB()
+{
+	return processManager ? getCurrentProcess(processManager) : NULL;
+}
+
 uint64_t schedule(uint64_t rsp)
 {
 	static int first = 1;
@@ -162,18 +201,54 @@ uint64_t schedule(uint64_t rsp)
 		return rsp;
 	}
 
+	/* a process that yields or blocks gives up the CPU; otherwise it is preempted */
+	int voluntary = voluntarySwitch || currentProcess->state != RUNNING;
+	voluntarySwitch = 0;
+
 	if (!first)
 		currentProcess->rsp = rsp;
 	else
 		first = 0;
 	if (currentProcess->state == RUNNING)
-		currentProcess->state = READY;
-
-	PCB *nextProcess = getNextProcess(processManager);
+		setProcessState(currentProcess, READY);
+
+	/* only the switch preemptOnWakeup asks for hands off; any other one drops the handoff */
+	PCB *nextProcess = NULL;
+	if (handingOff) {
+		nextProcess = takeReadyProcess(processManager, handoffPid);
+	}
+	handoffPid = -1;
+	handingOff = 0;
+	if (nextProcess != NULL && nextProcess->priority == currentProcess->priority && donatedQuantum > 0) {
+		/* same priority: the woken process only gets what the poster had left */
+		quantum = donatedQuantum;
+	} else {
+		if (nextProcess == NULL) {
+			nextProcess = getNextProcess(processManager);
+		}
+		quantum = calculateQuantum(nextProcess->priority);
+	}
+	donatedQuantum = 0;
 
-	nextProcess->state = RUNNING;
+	if (nextProcess != currentProcess) {
+		contextSwitches++;
+		uint64_t tsc = readTSC();
+		CpuStats *out = &currentProcess->cpu;
+		if (out->runningSince != 0) {
+			out->cpuCycles += tsc - out->runningSince;
+		}
+		if (voluntary) {
+			out->voluntarySwitches++;
+		} else {
+			out->involuntarySwitches++;
+		}
+		nextProcess->cpu.runningSince = tsc;
+	}
+	/* on every dispatch: the first one at boot does not switch processes */
+	kernelDataSetProcess(nextProcess);
+	nextProcess->cpu.lastRunTick = current_tick();
+	setProcessState(nextProcess, RUNNING);
 	currentPid = nextProcess->pid;
-	quantum = calculateQuantum(nextProcess->priority);
 	return nextProcess->rsp;
 }
 
@@ -199,10 +274,57 @@ uint64_t blockProcessBySem(pid_t pid)
 	return 0;
 }
 
-void yield()
+uint64_t sleepUntil(uint64_t wakeTick)
+{
+	if (sleepProcessQueue(processManager, getCurrentPid(), wakeTick) != 0) {
+		return -1;
+	}
+	yield();
+	return 0;
+}
+
+static uint64_t decayLoad(uint64_t load, uint64_t exp, uint64_t active)
+{
+	return (load * exp + active * (LOAD_FIXED_1 - exp)) >> LOAD_FSHIFT;
+}
+
+void schedulerTick(uint64_t now)
+{
+	PCB *current = getCurrentProcess(processManager);
+	if (current != NULL) {
+		current->cpu.cpuTicks++;
+	}
+	wakeSleepingProcesses(processManager, now);
+
+	if (now % (LOAD_SAMPLE_SECONDS * timer_frequency()) == 0) {
+		uint64_t active = readyProcessCount(processManager) * LOAD_FIXED_1;
+		loadAverage[0] = decayLoad(loadAverage[0], EXP_1, active);
+		loadAverage[1] = decayLoad(loadAverage[1], EXP_5, active);
+		loadAverage[2] = decayLoad(loadAverage[2], EXP_15, active);
+	}
+}
+
+void getSchedulerInfo(sysInfo *info)
+{
+	info->ticks = current_tick();
+	info->tickHz = timer_frequency();
+	info->contextSwitches = contextSwitches;
+	info->runnable = readyProcessCount(processManager);
+	for (int i = 0; i < 3; i++) {
+		info->loadAverage[i] = loadAverage[i];
+	}
+}
+
+static void reschedule(int voluntary)
 {
 	quantum = 0;
-	callTimerTick(); // aca
+	voluntarySwitch = voluntary;
+	callReschedule();
+}
+
+void yield()
+{
+	reschedule(1);
 }
 
 uint64_t unblockProcess(pid_t pid)
@@ -212,7 +334,33 @@ uint64_t unblockProcess(pid_t pid)
 
 uint64_t unblockProcessBySem(pid_t pid)
 {
-	return unblockProcessQueueBySem(processManager, pid);
+	if (unblockProcessQueueBySem(processManager, pid) != 0) {
+		return -1;
+	}
+#if WAKEUP_PREEMPTION
+	PCB *current = getCurrentProcess(processManager);
+	PCB *woken = getProcess(processManager, pid);
+	if (handoffPid == -1 && current != NULL && current->state == RUNNING && woken != NULL &&
+	    woken->priority <= current->priority) {
+		handoffPid = pid;
+	}
+#endif
+	return 0;
+}
+
+void discardWakeupHandoff()
+{
+	handoffPid = -1;
+}
+
+void preemptOnWakeup()
+{
+	if (handoffPid == -1) {
+		return;
+	}
+	donatedQuantum = quantum;
+	handingOff = 1;
+	reschedule(0);
 }
 
 uint64_t kill(pid_t pid, uint64_t retValue)
@@ -225,7 +373,8 @@ uint64_t kill(pid_t pid, uint64_t retValue)
 		return -1;
 	}
 
-	freeMemory((void*)process->base - PROCESS_STACK_SIZE);
+	freeStack((void*)(process->base - process->stackSize), process->stackSize);
+	releaseArena(process);
 	
 	// Handle parent's children_sem if this was a foreground child
 	pid_t parentPid = process->parentPid;
@@ -250,8 +399,7 @@ uint64_t kill(pid_t pid, uint64_t retValue)
 	}
 
 	if (pid == currentPid) {
-		quantum = 0;
-		callTimerTick();
+		reschedule(1);
 	}
 	return 0;
 }
@@ -266,7 +414,7 @@ static int32_t reapCild(PCB *child, int32_t *retValue)
 
 	child->state = child->retValue;
 	removeFromZombie(processManager, childPid);
-	freeMemory(child);
+	kmem_cache_free(pcbCache, child);
 
 	return childPid;
 }
@@ -313,10 +461,10 @@ int32_t waitpid(pid_t pid, int32_t *retValue)
 
 	if (target->state < ZOMBIE) {
 		current->waitingForPid = pid;
-		current->state = BLOCKED;
+		setProcessState(current, BLOCKED);
 		if (blockProcess(currentProcPid) != 0) {
 			current->waitingForPid = -1;
-			current->state = READY;
+			setProcessState(current, READY);
 			return -1;
 		}
 		target = getProcess(processManager, pid);
@@ -348,6 +496,7 @@ int8_t changePrio(pid_t pid, int8_t newPrio)
 		newPrio = MAX_PRIORITY;
 	}
 	process->priority = newPrio;
+	updateReadyPriority(processManager, process);
 	return newPrio;
 }
 
@@ -360,21 +509,21 @@ PCB *getProcessInfo(uint64_t *cantProcesses)
 
 	uint64_t count = processCount(processManager);
 
-	PCB *processInfo = allocMemory(sizeof(PCB) * count);
+	/* handed to userland, which releases it with FREE_MEMORY */
+	PCB *processInfo = arenaAlloc(getCurrentPCB(), sizeof(PCB) * count);
 	if (processInfo == NULL) {
 		*cantProcesses = 0;
 		return NULL;
 	}
 
 	uint64_t j = 0;
-	for (uint64_t i = 0; j < count; i++) {
-		PCB *process = getProcess(processManager, i);
-		if (process != NULL) {
-			if (copyProcess(&processInfo[j++], process) == -1) {
-				freeMemory(processInfo);
-				*cantProcesses = 0;
-				return NULL;
-			}
+	uint64_t cursor = 0;
+	PCB *process;
+	while (j < count && (process = nextProcessInTable(processManager, &cursor)) != NULL) {
+		if (copyProcess(&processInfo[j++], process) == -1) {
+			arenaFree(processInfo);
+			*cantProcesses = 0;
+			return NULL;
 		}
 	}
 
@@ -382,8 +531,28 @@ PCB *getProcessInfo(uint64_t *cantProcesses)
 	return processInfo;
 }
 
+/*
+ * readCpuStats (static)
+ * Copies the CPU counters of `process`, folding in the time accumulated
+ * since its last state change.
+ */
+static void readCpuStats(PCB *process, CpuStats *dest)
+{
+	*dest = process->cpu;
+	uint64_t elapsed = current_tick() - process->cpu.stateSince;
+	if (process->state == READY) {
+		dest->readyTicks += elapsed;
+	} else if (process->state == BLOCKED) {
+		dest->blockedTicks += elapsed;
+	} else if (process->state == RUNNING && process->cpu.runningSince != 0) {
+		dest->cpuCycles += readTSC() - process->cpu.runningSince;
+	}
+}
+
 int16_t copyProcess(PCB *dest, PCB *src)
 {
+	/* the copy goes to userland: fields not copied below stay zeroed */
+	memset(dest, 0, sizeof(PCB));
 	dest->pid = src->pid;
 	dest->parentPid = src->parentPid;
 	dest->waitingForPid = src->waitingForPid;
@@ -391,6 +560,7 @@ int16_t copyProcess(PCB *dest, PCB *src)
 	dest->state = src->state;
 	dest->rsp = src->rsp;
 	dest->base = src->base;
+	dest->stackSize = src->stackSize;
 	dest->entryPoint = src->entryPoint;
 	strncpy(dest->name, src->name, NAME_MAX_LENGTH);
 	dest->name[NAME_MAX_LENGTH - 1] = '\0';
@@ -398,9 +568,46 @@ int16_t copyProcess(PCB *dest, PCB *src)
 	dest->foreground = src->foreground;
 	dest->stdin = src->stdin;
 	dest->stdout = src->stdout;
+	dest->memoryUsed = src->memoryUsed;
+	readCpuStats(src, &dest->cpu);
 	return 0;
 }
 
+uint64_t getProcessStats(uint64_t *cursor, procStat *buffer, uint64_t capacity)
+{
+	if (processManager == NULL || cursor == NULL || buffer == NULL) {
+		return 0;
+	}
+
+	uint64_t filled = 0;
+	PCB *process;
+	while (filled < capacity && (process = nextProcessInTable(processManager, cursor)) != NULL) {
+		procStat *stat = &buffer[filled++];
+		CpuStats cpu;
+		readCpuStats(process, &cpu);
+
+		stat->version = PROC_STAT_VERSION;
+		stat->size = sizeof(procStat);
+		stat->pid = process->pid;
+		stat->parentPid = process->parentPid;
+		stat->priority = process->priority;
+		stat->state = process->state;
+		stat->foreground = process->foreground;
+		stat->reserved = 0;
+		stat->memoryUsed = process->memoryUsed;
+		stat->cpuTicks = cpu.cpuTicks;
+		stat->cpuCycles = cpu.cpuCycles;
+		stat->voluntarySwitches = cpu.voluntarySwitches;
+		stat->involuntarySwitches = cpu.involuntarySwitches;
+		stat->readyTicks = cpu.readyTicks;
+		stat->blockedTicks = cpu.blockedTicks;
+		stat->lastRunTick = cpu.lastRunTick;
+		strncpy(stat->name, process->name, NAME_MAX_LENGTH);
+		stat->name[NAME_MAX_LENGTH - 1] = '\0';
+	}
+	return filled;
+}
+
 // Add new functions to access current process information
 int getCurrentStdin()
 {
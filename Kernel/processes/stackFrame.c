@@ -3,6 +3,7 @@
 #include <memoryManager.h>
 #include <process.h>
 #include <stackFrame.h>
+#include <stackPool.h>
 
 // To set up stack frame
 /* copyToStack (static)
@@ -11,15 +12,15 @@
  */
 static char **copyToStack(uint64_t *paramsBase, uint64_t argc, char **argv);
 
-uint64_t setUpStackFrame(uint64_t *base, uint64_t entryPoint, uint64_t argc, char **argv)
+uint64_t setUpStackFrame(uint64_t *base, uint64_t *stackSize, uint64_t entryPoint, uint64_t argc, char **argv)
 {
-	/* allocate stack and position the base at the top */
-	*base = (uint64_t)allocMemory(PROCESS_STACK_SIZE);
+	/* take a stack from the pool and position the base at the top */
+	*base = (uint64_t)allocStack(stackSize);
 	if (*base == 0) {
 		return 0;
 	}
 
-	*base += PROCESS_STACK_SIZE;
+	*base += *stackSize;
 
 	/* copy parameters and prepare argv on the stack, then create final frame */
 	uint64_t paramsBase = *base; /* space for parameters */
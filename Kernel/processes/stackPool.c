@@ -0,0 +1,103 @@
+#include <memoryManager.h>
+#include <process.h>
+#include <stackPool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static const uint64_t stackClassSize[STACK_CLASS_COUNT] = {PROCESS_STACK_SIZE, 4 * PROCESS_STACK_SIZE,
+                                                           16 * PROCESS_STACK_SIZE};
+
+/* Stacks start on a page boundary; class sizes are multiples of it, so both ends stay aligned */
+#define STACK_ALIGNMENT 4096
+
+/* Free stacks keep the link at their lowest address, far from the live top */
+typedef struct stackNode {
+	struct stackNode *next;
+} stackNode;
+
+static stackNode *freeStacks[STACK_CLASS_COUNT];
+
+static int sizeToClass(uint64_t size);
+static int refillClass(int stackClass);
+
+/*
+ * sizeToClass
+ * @return: smallest class whose stacks hold `size` bytes, or -1 if none
+ */
+static int sizeToClass(uint64_t size)
+{
+	for (int i = 0; i < STACK_CLASS_COUNT; i++) {
+		if (size <= stackClassSize[i]) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+ * refillClass
+ * Carves STACKS_PER_REFILL stacks of `stackClass` from a single heap chunk.
+ * Buddy blocks are aligned to their own size, so the exact request is
+ * enough there; only a misaligned chunk (TLSF, bitmap) is swapped for one
+ * with STACK_ALIGNMENT - 1 spare bytes to round up. Over-allocating up
+ * front would push every buddy refill into the next order. Chunks stay in
+ * the pool; it is bounded by the peak number of live stacks.
+ * @return: 0 on success, -1 if the memory manager is out of memory
+ */
+static int refillClass(int stackClass)
+{
+	uint64_t size = stackClassSize[stackClass];
+	uint8_t *chunk = allocMemory(size * STACKS_PER_REFILL);
+	if (chunk != NULL && ((uintptr_t)chunk & (STACK_ALIGNMENT - 1)) != 0) {
+		freeMemory(chunk);
+		chunk = allocMemory(size * STACKS_PER_REFILL + STACK_ALIGNMENT - 1);
+		if (chunk == NULL) {
+			return -1;
+		}
+		chunk = (uint8_t *)(((uintptr_t)chunk + STACK_ALIGNMENT - 1) & ~(uintptr_t)(STACK_ALIGNMENT - 1));
+	}
+	if (chunk == NULL) {
+		return -1;
+	}
+	for (int i = 0; i < STACKS_PER_REFILL; i++) {
+		freeStack(chunk + i * size, size);
+	}
+	return 0;
+}
+
+void createStackPool(void)
+{
+	for (int i = 0; i < STACK_CLASS_COUNT; i++) {
+		freeStacks[i] = NULL;
+	}
+	refillClass(0);
+}
+
+void *allocStack(uint64_t *size)
+{
+	if (*size == 0) {
+		*size = PROCESS_STACK_SIZE;
+	}
+	int stackClass = sizeToClass(*size);
+	if (stackClass < 0) {
+		return NULL;
+	}
+	if (freeStacks[stackClass] == NULL && refillClass(stackClass) != 0) {
+		return NULL;
+	}
+	stackNode *stack = freeStacks[stackClass];
+	freeStacks[stackClass] = stack->next;
+	*size = stackClassSize[stackClass];
+	return stack;
+}
+
+void freeStack(void *stack, uint64_t size)
+{
+	int stackClass = sizeToClass(size);
+	if (stack == NULL || stackClass < 0 || stackClassSize[stackClass] != size) {
+		return;
+	}
+	stackNode *node = stack;
+	node->next = freeStacks[stackClass];
+	freeStacks[stackClass] = node;
+}
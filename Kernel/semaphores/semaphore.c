@@ -3,12 +3,14 @@
 #include <memoryManager.h>
 #include <queue.h>
 #include <scheduler.h>
+#include <slab.h>
 
 typedef struct SemaphoreCDT {
     sem_t semaphores[NUM_SEMS];
 } SemaphoreCDT;
 
 SemaphoreADT manager = NULL;
+static kmem_cache_t *waiterCache = NULL; /* pid_t entries queued by wait() */
 
 #define validateid(id) \
     do{ \
@@ -23,6 +25,12 @@ SemaphoreADT createSemaphoresManager(){
     if (manager == NULL) {
         return NULL;
     }
+    waiterCache = kmem_cache_create("sem_waiter", sizeof(pid_t));
+    if (waiterCache == NULL) {
+        freeMemory(manager);
+        manager = NULL;
+        return NULL;
+    }
 
     for (int i = 0; i < NUM_SEMS; i++) {
         manager->semaphores[i].value = 0;
@@ -100,7 +108,7 @@ int wait (sem_t *sem){
         release(&sem->lock);
         return 0;
     }
-    pid_t *pid = (pid_t *)allocMemory(sizeof(pid_t));
+    pid_t *pid = (pid_t *)kmem_cache_alloc(waiterCache);
     if (pid == NULL) {
         release(&sem->lock);
         return -1; // Memory allocation failed
@@ -117,7 +125,7 @@ int post (sem_t *sem){
     pid_t *pidPtr = (pid_t *)dequeue(sem->blocked);
     if (pidPtr != NULL) {
         pid_t pid = *pidPtr;
-        freeMemory(pidPtr);  // Free the memory allocated in wait()
+        kmem_cache_free(waiterCache, pidPtr);  // Free the entry allocated in wait()
         unblockProcessBySem(pid);
         release(&sem->lock);
         return 0;   
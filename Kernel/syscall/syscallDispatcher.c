@@ -1,6 +1,8 @@
 #include "memoryManager.h"
+#include <arena.h>
 #include <clock.h>
 #include <defs.h>
+#include <kernelData.h>
 #include <keyboardDriver.h>
 #include <lib.h>
 #include <pipe.h>
@@ -14,14 +16,14 @@
 #include <videoDriver.h>
 
 #define CANT_REGS 19
-#define CANT_SYSCALLS 30
 #define MAX_PIPES 16
 extern uint64_t regs[CANT_REGS];
 
 typedef struct Point2D {
 	uint64_t x, y;
 } Point2D;
-typedef uint64_t (*syscall_fn)(uint64_t rbx, uint64_t rcx, uint64_t rdx);
+typedef uint64_t (*syscall_fn)(uint64_t arg1, uint64_t arg2, uint64_t arg3, uint64_t arg4, uint64_t arg5,
+                               uint64_t arg6);
 
 
 static uint64_t syscall_write(uint64_t fd, char *buff, uint64_t length)
@@ -114,15 +116,27 @@ static uint64_t syscall_wait_seconds(uint64_t seconds) {
 
 static uint64_t syscall_allocMemory(uint64_t size)
 {
-	return (uint64_t)allocMemory(size);
+	return (uint64_t)arenaAlloc(getCurrentPCB(), size);
 }
 
 static uint64_t syscall_freeMemory(uint64_t address)
 {
-	freeMemory((void *)address);
+	arenaFree((void *)address);
 	return 0;
 }
 
+static uint64_t syscall_sbrk(uint64_t increment)
+{
+	/* chunks live in the caller's arena: kill and exit reclaim them */
+	PCB *process = getCurrentPCB();
+	void *chunk = arenaAlloc(process, increment);
+	if (chunk != NULL && process->heapBase == NULL) {
+		process->heapBase = chunk;
+		kernelDataSetProcess(process);
+	}
+	return (uint64_t)chunk;
+}
+
 static inline uint64_t argCounter(char **argv)
 {
 	uint64_t c = 0;
@@ -135,10 +149,15 @@ static inline uint64_t argCounter(char **argv)
 	return c;
 }
 
-pid_t syscall_create_process(ProcessParams *p)
+/*
+ * flags: priority in bits 0-7, foreground in bit 8
+ * fds: stdin in the low 32 bits, stdout in the high 32 bits
+ */
+pid_t syscall_create_process(char *name, processFun function, char **argv, uint64_t flags, uint64_t fds,
+                             uint64_t stackSize)
 {
-	return createProcess(p->name, (processFun)p->function, argCounter(p->arg), p->arg, p->priority, p->foreground,
-	                     p->stdin, p->stdout);
+	return createProcess(name, function, argCounter(argv), argv, flags & 0xFF, (flags >> 8) & 1, (int32_t)fds,
+	                     (int32_t)(fds >> 32), stackSize);
 }
 
 static uint64_t syscall_exit(uint64_t ret)
@@ -183,6 +202,11 @@ static PCB *syscall_getProcessInfo(uint64_t *cantProcesses)
 	return getProcessInfo(cantProcesses);
 }
 
+static uint64_t syscall_procStat(uint64_t *cursor, procStat *buffer, uint64_t capacity)
+{
+	return getProcessStats(cursor, buffer, capacity);
+}
+
 static int64_t syscall_memInfo(memInfo *user_ptr)
 {
 	if (user_ptr == NULL) {
@@ -197,6 +221,15 @@ static int64_t syscall_memInfo(memInfo *user_ptr)
 	return 0;
 }
 
+static int64_t syscall_sysInfo(sysInfo *user_ptr)
+{
+	if (user_ptr == NULL) {
+		return -1;
+	}
+	getSchedulerInfo(user_ptr);
+	return 0;
+}
+
 int syscall_sem_wait(int sem_id)
 {
 	if (sem_id < 0 || sem_id >= NUM_SEMS)
@@ -225,9 +258,18 @@ int syscall_sem_open(int sem_id, uint64_t initial_Value)
 	return semInit(sem_id, initial_Value);
 }
 
-int syscall_openPipe()
+int syscall_openPipe(uint64_t size, uint64_t flags)
+{
+	if (size > PIPE_MAX_SIZE)
+		return -1;
+	return createPipe(size, flags);
+}
+
+int syscall_resizePipe(int pipe_id, uint64_t size)
 {
-	return createPipe();
+	if (pipe_id <= 2 || size > PIPE_MAX_SIZE)
+		return -1;
+	return pipeResize(pipe_id, size);
 }
 
 int syscall_closePipe(int pipe_id)
@@ -245,45 +287,139 @@ pid_t syscall_waitPid(pid_t pid, int32_t *retValue)
 	return waitpid(pid, retValue);
 }
 
-uint64_t syscallDispatcher(uint64_t syscall_number, uint64_t arg1, uint64_t arg2, uint64_t arg3)
+static int64_t runIoOp(ioSubmission *sqe)
+{
+	switch (sqe->op) {
+	case IO_OP_NOP:
+		return 0;
+	case IO_OP_READ:
+		return syscall_read(sqe->fd, (char *)sqe->addr, sqe->len);
+	case IO_OP_WRITE:
+		return syscall_write(sqe->fd, (char *)sqe->addr, sqe->len);
+	case IO_OP_SEM_WAIT:
+		return syscall_sem_wait(sqe->fd);
+	case IO_OP_SEM_POST:
+		return syscall_sem_post(sqe->fd);
+	case IO_OP_WAIT:
+		return syscall_wait(sqe->len);
+	default:
+		return -1;
+	}
+}
+
+static int64_t syscall_ioRingSetup(ioRing *ring)
+{
+	PCB *current = getCurrentPCB();
+	if (current == NULL) {
+		return -1;
+	}
+	current->ioRing = ring; /* NULL unregisters */
+	return 0;
+}
+
+/*
+ * Runs up to `toSubmit` queued operations in order, one completion each.
+ * Stops early when the completion queue is full.
+ */
+static int64_t syscall_ioRingEnter(uint64_t toSubmit)
+{
+	PCB *current = getCurrentPCB();
+	if (current == NULL || current->ioRing == NULL) {
+		return -1;
+	}
+
+	ioRing *ring = current->ioRing;
+	uint64_t done = 0;
+	while (done < toSubmit && ring->sqHead != ring->sqTail && ring->cqTail - ring->cqHead < IO_RING_ENTRIES) {
+		ioSubmission sqe = ring->sq[ring->sqHead & IO_RING_MASK];
+		ring->sqHead++;
+
+		int64_t result = runIoOp(&sqe);
+
+		ioCompletion *cqe = &ring->cq[ring->cqTail & IO_RING_MASK];
+		cqe->userData = sqe.userData;
+		cqe->result = result;
+		ring->cqTail++;
+		done++;
+	}
+	return done;
+}
+
+static uint64_t syscall_syscallStats(uint64_t *calls, uint64_t *cycles, uint64_t capacity);
+
+/* indexed by syscall number, entry 0 is unused */
+static const syscall_fn syscalls[] = {
+    NULL,
+    (syscall_fn)syscall_read,
+    (syscall_fn)syscall_write,
+    (syscall_fn)syscall_clearScreen,
+    (syscall_fn)syscall_fontSizeUp,
+    (syscall_fn)syscall_fontSizeDown,
+    (syscall_fn)syscall_getHeight,
+    (syscall_fn)syscall_getWidth,
+    (syscall_fn)syscall_wait,
+    (syscall_fn)syscall_allocMemory,
+    (syscall_fn)syscall_freeMemory,
+    (syscall_fn)syscall_create_process,
+    (syscall_fn)syscall_getpid,
+    (syscall_fn)syscall_kill,
+    (syscall_fn)syscall_block,
+    (syscall_fn)syscall_unblock,
+    (syscall_fn)syscall_changePrio,
+    (syscall_fn)syscall_getProcessInfo,
+    (syscall_fn)syscall_memInfo,
+    (syscall_fn)syscall_exit,
+    (syscall_fn)syscall_sem_open,
+    (syscall_fn)syscall_sem_wait,
+    (syscall_fn)syscall_sem_post,
+    (syscall_fn)syscall_sem_close,
+    (syscall_fn)syscall_yield,
+    (syscall_fn)syscall_openPipe,
+    (syscall_fn)syscall_closePipe,
+    (syscall_fn)syscall_clearPipe,
+    (syscall_fn)syscall_waitPid,
+    (syscall_fn)syscall_write_color,
+    (syscall_fn)syscall_wait_seconds,
+    (syscall_fn)syscall_sbrk,
+    (syscall_fn)syscall_sysInfo,
+    (syscall_fn)syscall_procStat,
+    (syscall_fn)syscall_syscallStats,
+    (syscall_fn)syscall_ioRingSetup,
+    (syscall_fn)syscall_ioRingEnter,
+    (syscall_fn)syscall_resizePipe,
+};
+
+#define CANT_SYSCALLS (sizeof(syscalls) / sizeof(syscalls[0]))
+
+/* calls and TSC cycles per syscall; blocking calls include the time blocked */
+static uint64_t syscallCalls[CANT_SYSCALLS];
+static uint64_t syscallCycles[CANT_SYSCALLS];
+
+static uint64_t syscall_syscallStats(uint64_t *calls, uint64_t *cycles, uint64_t capacity)
+{
+	for (uint64_t i = 0; i < capacity && i < CANT_SYSCALLS; i++) {
+		if (calls != NULL) {
+			calls[i] = syscallCalls[i];
+		}
+		if (cycles != NULL) {
+			cycles[i] = syscallCycles[i];
+		}
+	}
+	return CANT_SYSCALLS;
+}
+
+uint64_t syscallDispatcher(uint64_t syscall_number, uint64_t arg1, uint64_t arg2, uint64_t arg3, uint64_t arg4,
+                           uint64_t arg5, uint64_t arg6)
 {
-	if (syscall_number > CANT_SYSCALLS)
+	if (syscall_number >= CANT_SYSCALLS || syscalls[syscall_number] == NULL)
 		return 0;
 	_cli();
-	syscall_fn syscalls[] = {
-	    0,
-	    (syscall_fn)syscall_read,
-	    (syscall_fn)syscall_write,
-	    (syscall_fn)syscall_clearScreen,
-	    (syscall_fn)syscall_fontSizeUp,
-	    (syscall_fn)syscall_fontSizeDown,
-	    (syscall_fn)syscall_getHeight,
-	    (syscall_fn)syscall_getWidth,
-	    (syscall_fn)syscall_wait,
-	    (syscall_fn)syscall_allocMemory,
-	    (syscall_fn)syscall_freeMemory,
-	    (syscall_fn)syscall_create_process,
-	    (syscall_fn)syscall_getpid,
-	    (syscall_fn)syscall_kill,
-	    (syscall_fn)syscall_block,
-	    (syscall_fn)syscall_unblock,
-	    (syscall_fn)syscall_changePrio,
-	    (syscall_fn)syscall_getProcessInfo,
-	    (syscall_fn)syscall_memInfo,
-	    (syscall_fn)syscall_exit,
-	    (syscall_fn)syscall_sem_open,
-	    (syscall_fn)syscall_sem_wait,
-	    (syscall_fn)syscall_sem_post,
-	    (syscall_fn)syscall_sem_close,
-	    (syscall_fn)syscall_yield,
-	    (syscall_fn)syscall_openPipe,
-	    (syscall_fn)syscall_closePipe,
-	    (syscall_fn)syscall_clearPipe,
-	    (syscall_fn)syscall_waitPid,
-	    (syscall_fn)syscall_write_color,
-	    (syscall_fn)syscall_wait_seconds,
-	};
-	uint64_t ret = syscalls[syscall_number](arg1, arg2, arg3);
+	discardWakeupHandoff();
+	uint64_t start = readTSC();
+	uint64_t ret = syscalls[syscall_number](arg1, arg2, arg3, arg4, arg5, arg6);
+	syscallCycles[syscall_number] += readTSC() - start;
+	syscallCalls[syscall_number]++;
+	preemptOnWakeup();
 	_sti();
 	return ret;
 }
\ No newline at end of file
@@ -11,6 +11,17 @@ typedef struct memInfo {
     uint64_t free;
 } memInfo;
 
+#define LOAD_FSHIFT 11                 // Fraction bits of loadAverage
+#define LOAD_FIXED_1 (1 << LOAD_FSHIFT) // 1.0 in fixed point
+
+typedef struct sysInfo {
+    uint64_t ticks;           // Timer ticks since boot
+    uint64_t tickHz;          // Timer ticks per second
+    uint64_t contextSwitches; // Context switches since boot
+    uint64_t runnable;        // READY or RUNNING processes, idle excluded
+    uint64_t loadAverage[3];  // 1, 5 and 15 minute load averages, fixed point
+} sysInfo;
+
 
 typedef enum {
     READY,
@@ -28,6 +39,25 @@ typedef int pid_t;
 typedef uint64_t (*processFun)(uint64_t argc, char **argv);
 
 
+// Nodo de lista circular doblemente enlazada, embebido en la estructura que se encola
+typedef struct ListNode {
+    struct ListNode *next;
+    struct ListNode *prev;
+} ListNode;
+
+// CPU accounting of a process, in timer ticks except for cpuCycles
+typedef struct CpuStats {
+    uint64_t cpuTicks;            // Ticks the process was RUNNING on
+    uint64_t cpuCycles;           // TSC cycles spent RUNNING
+    uint64_t voluntarySwitches;   // Gave up the CPU (yield, block, sleep)
+    uint64_t involuntarySwitches; // Preempted at quantum end or by a wakeup
+    uint64_t readyTicks;          // Ticks spent waiting in the ready queues
+    uint64_t blockedTicks;        // Ticks spent BLOCKED
+    uint64_t lastRunTick;         // Tick at which it was last scheduled
+    uint64_t stateSince;          // Tick of the last state change
+    uint64_t runningSince;        // TSC value when it was last switched in
+} CpuStats;
+
 typedef struct {
     pid_t pid;
     pid_t parentPid;
@@ -36,6 +66,7 @@ typedef struct {
     State state;
     uint64_t rsp;
     uint64_t base;
+    uint64_t stackSize;
     uint64_t entryPoint;
     uint64_t retValue;
     char foreground;
@@ -44,17 +75,103 @@ typedef struct {
     int stdout;
     int children_sem;  // Semaphore ID for waiting on children, -1 if not used
     int children_count; // Number of foreground children
+    ListNode arena;      // Blocks allocated on behalf of the process
+    uint64_t memoryUsed; // Bytes currently held in the arena
+    ListNode queueLink;  // Link in the kernel queue holding the process
+    void *queue;         // Kernel queue the process is linked in, NULL if none
+    uint64_t wakeTick;   // Tick at which a sleeping process is woken up
+    CpuStats cpu;        // CPU usage counters
+    void *ioRing;        // Submission/completion ring registered by the process, NULL if none
+    void *heapBase;      // First SBRK chunk, holds the process' malloc state; NULL before it
     char name[NAME_MAX_LENGTH];
 } PCB;
 
-typedef struct ProcessParams {
-    char* name;
-    processFun function;
+// Pipe creation flags
+#define PIPE_SPSC 1 // Exactly one reader and one writer: lock-free ring, no mutex
+
+// Page the kernel keeps up to date for userland to read with plain loads.
+// It is the last page of the data module area (0x500000 - 0x5FFFFF), which
+// the data module does not reach and the bootloader does not use.
+#define KERNEL_DATA_ADDRESS 0x5FF000
+
+typedef struct wallClock {
+    uint8_t sec;
+    uint8_t min;
+    uint8_t hour;
+    uint8_t day;
+    uint8_t month;
+    uint16_t year;
+} wallClock;
+
+typedef struct kernelData {
+    volatile uint32_t sequence; // Odd while the kernel is writing: readers retry
+    volatile pid_t pid;         // Process currently running
+    void *volatile heapBase;    // heapBase of the process currently running
+    volatile uint64_t ticks;    // Timer ticks since boot
+    uint64_t tickHz;            // Timer ticks per second
+    volatile uint64_t tscAtTick;  // TSC value at the last tick
+    volatile uint64_t tscPerTick; // TSC cycles per tick, measured over the last second
+    wallClock clock;            // RTC time (UTC), refreshed once per second
+} kernelData;
+
+#define IO_RING_ENTRIES 32 // power of two
+#define IO_RING_MASK (IO_RING_ENTRIES - 1)
+
+// Operations that can be queued on an ioRing
+typedef enum {
+    IO_OP_NOP,
+    IO_OP_READ,     // fd, addr, len
+    IO_OP_WRITE,    // fd, addr, len
+    IO_OP_SEM_WAIT, // fd = semaphore id
+    IO_OP_SEM_POST, // fd = semaphore id
+    IO_OP_WAIT      // len = ticks
+} ioOp;
+
+typedef struct ioSubmission {
+    uint32_t op;       // ioOp
+    int32_t fd;
+    uint64_t addr;
+    uint64_t len;
+    uint64_t userData; // Copied to the matching completion
+} ioSubmission;
+
+typedef struct ioCompletion {
+    uint64_t userData;
+    int64_t result;    // Return value of the operation
+} ioCompletion;
+
+// Shared submission/completion ring. Indexes run freely and are masked on use:
+// userland produces sqTail and consumes cqHead, the kernel the other two.
+typedef struct ioRing {
+    volatile uint32_t sqHead;
+    volatile uint32_t sqTail;
+    volatile uint32_t cqHead;
+    volatile uint32_t cqTail;
+    ioSubmission sq[IO_RING_ENTRIES];
+    ioCompletion cq[IO_RING_ENTRIES];
+} ioRing;
+
+#define PROC_STAT_VERSION 1
+
+// Compact, versioned per-process record filled by the process-stat syscall
+typedef struct procStat {
+    uint32_t version;    // PROC_STAT_VERSION
+    uint32_t size;       // sizeof(procStat) as seen by the kernel
+    pid_t pid;
+    pid_t parentPid;
     int8_t priority;
-    char** arg;
-    char foreground;
-    int stdin;
-    int stdout;  
-} ProcessParams;
+    uint8_t state;       // State
+    uint8_t foreground;
+    uint8_t reserved;
+    uint64_t memoryUsed;
+    uint64_t cpuTicks;
+    uint64_t cpuCycles;
+    uint64_t voluntarySwitches;
+    uint64_t involuntarySwitches;
+    uint64_t readyTicks;
+    uint64_t blockedTicks;
+    uint64_t lastRunTick;
+    char name[NAME_MAX_LENGTH];
+} procStat;
 
 #endif 
\ No newline at end of file
@@ -11,12 +11,14 @@ syscall:
     push r13
     push r15
  
-    mov rax, rdi
-    mov rbx, rsi
-    mov rdi, rdx 
-    mov rdx, rcx
-    mov rcx, rdi
-    int 80h        ; efectúa la syscall 
+    mov rax, rdi   ; número de syscall
+    mov rdi, rsi   ; primer parámetro
+    mov rsi, rdx   ; segundo parámetro
+    mov rdx, rcx   ; tercer parámetro
+    mov r10, r8    ; cuarto parámetro (rcx lo pisa SYSCALL)
+    mov r8, r9     ; quinto parámetro
+    mov r9, [rbp + 16] ; sexto parámetro, pasado por stack
+    syscall        ; efectúa la syscall (pisa rcx y r11)
     
     pop r15 
     pop r13
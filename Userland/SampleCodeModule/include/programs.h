@@ -45,6 +45,8 @@ void printProcessInfo(PCB processInfo);
 
 // programs
 void loop(uint64_t argc, char *argv[]);
+uint64_t top(uint64_t argc, char *argv[]);
+uint64_t sysstat(uint64_t argc, char *argv[]);
 uint64_t cat(uint64_t argc, char *argv[]);
 uint64_t wc(uint64_t argc, char *argv[]);
 uint64_t filter(uint64_t argc, char *argv[]);
@@ -29,6 +29,8 @@ pid_t handle_test_sync(char *arg, int sdtin, int stdout);
 pid_t handle_ps(char *arg, int sdtin, int stdout);
 pid_t handle_mem_info(char *arg, int sdtin, int stdout);
 pid_t handle_loop(char *arg, int sdtin, int stdout);
+pid_t handle_top(char *arg, int sdtin, int stdout);
+pid_t handle_sysstat(char *arg, int sdtin, int stdout);
 pid_t handle_pid_info(char *arg, int sdtin, int stdout);
 pid_t handle_nice(char *arg, int sdtin, int stdout);
 pid_t handle_wc(char *arg, int sdtin, int stdout);
@@ -140,6 +140,10 @@ int checkNumber(char *str);
 
 /**
  * @brief Libera memoria dinámica
+ * Cualquier proceso puede liberar un bloque. Los de hasta 2 KB vuelven al
+ * heap del proceso que los reservó: si los libera otro, quedan en una lista
+ * remota que el dueño recupera en su próximo malloc. Los bloques de un
+ * proceso que ya terminó se liberaron con él y no se deben pasar a free.
  * @param ptr puntero a la memoria a liberar
  */
 void free(void *ptr);
@@ -167,4 +171,64 @@ char *itoa(int n);
 
 int checkNumber(char *str);
 
+/**
+ * @brief Inicializa un anillo de syscalls y lo registra en el kernel
+ * @param ring anillo a inicializar (debe vivir hasta io_ring_exit)
+ * @return 0 si se registró, -1 si no
+ */
+int io_ring_init(ioRing *ring);
+
+/**
+ * @brief Desregistra el anillo del proceso
+ */
+void io_ring_exit(ioRing *ring);
+
+/**
+ * @brief Encola una operación sin entrar al kernel
+ * @param op operación (ioOp)
+ * @param fd descriptor o id de semáforo
+ * @param addr buffer de la operación
+ * @param len bytes a transferir o ticks a esperar
+ * @param userData valor que vuelve en la completion
+ * @return 0 si se encoló, -1 si la cola de envío está llena
+ */
+int io_ring_prep(ioRing *ring, ioOp op, int fd, void *addr, uint64_t len, uint64_t userData);
+
+/**
+ * @brief Envía al kernel todas las operaciones encoladas con una sola syscall
+ * @return cantidad de operaciones completadas, -1 si hubo error
+ */
+int64_t io_ring_submit(ioRing *ring);
+
+/**
+ * @brief Saca una completion del anillo
+ * @param cqe donde se copia la completion
+ * @return 1 si había una completion, 0 si no
+ */
+int io_ring_reap(ioRing *ring, ioCompletion *cqe);
+
+// ========== PAGINA DE DATOS DEL KERNEL ==========
+// Se leen de la página que el kernel actualiza en cada tick y cambio de contexto, sin syscall
+
+/**
+ * @brief PID del proceso que está corriendo
+ */
+pid_t getpid();
+
+/**
+ * @brief Ticks del timer desde el arranque
+ */
+uint64_t getTicks();
+
+/**
+ * @brief Ciclos de TSC por tick, medidos sobre el último segundo (0 antes del primer segundo)
+ */
+uint64_t getCyclesPerTick();
+
+/**
+ * @brief Fecha y hora del RTC (UTC), actualizada una vez por segundo
+ * @param clock donde se copia la hora
+ */
+void getWallClock(wallClock *clock);
+
 #endif // STDLIB_H
\ No newline at end of file
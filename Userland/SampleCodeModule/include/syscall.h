@@ -6,6 +6,7 @@
 
 #define NAME_MAX_LENGTH 32
 #define STDIN 0
+#define STDOUT 1
 
 typedef struct Point2D {
 	uint64_t x, y;
@@ -28,17 +29,34 @@ int syscall_exit();
 // Memoria
 void *syscall_allocMemory(uint64_t size);
 int syscall_freeMemory(void *address);
+// Trozo de increment bytes para el heap del proceso; el primero queda como su heapBase.
+// Se cuenta en la memoria del proceso y se libera cuando termina
+void *syscall_sbrk(uint64_t increment);
 int64_t syscall_memInfo(memInfo *info);
 
+// Estadisticas del scheduler (ticks, cambios de contexto, carga promedio)
+int64_t syscall_sysInfo(sysInfo *info);
+
+// Copia hasta capacity contadores de llamadas y ciclos por syscall. Devuelve la cantidad de syscalls del kernel
+uint64_t syscall_syscallStats(uint64_t *calls, uint64_t *cycles, uint64_t capacity);
+// Nombre legible de la syscall number
+const char *syscall_name(uint64_t number);
+
 // Procesos
 uint64_t syscall_create_process(char *name, processFun function, char *argv[], uint8_t priority, char foreground,
                                 int stdin, int stdout);
+// Igual que syscall_create_process, con el tamaño de stack en bytes (0 = por defecto)
+uint64_t syscall_create_process_with_stack(char *name, processFun function, char *argv[], uint8_t priority,
+                                           char foreground, int stdin, int stdout, uint64_t stackSize);
 uint64_t syscall_getpid();
 uint64_t syscall_kill(uint64_t pid);
 uint64_t syscall_block(uint64_t pid);
 uint64_t syscall_unblock(uint64_t pid);
 int8_t syscall_changePrio(uint64_t pid, int8_t newPrio);
 PCB *syscall_getProcessInfo(uint64_t *cantProcesses);
+// Llena buffer con hasta capacity registros procStat desde *cursor (0 para empezar) y lo avanza.
+// Devuelve la cantidad escrita; 0 cuando no quedan procesos
+uint64_t syscall_procStat(uint64_t *cursor, procStat *buffer, uint64_t capacity);
 int syscall_yield();
 pid_t syscall_waitpid(pid_t pid, int32_t *status);
 
@@ -48,8 +66,18 @@ int syscall_sem_wait(int sem_id);
 int syscall_sem_post(int sem_id);
 int syscall_sem_close(int sem_id);
 
+// Anillo de envio/completado: registra el anillo (NULL lo desregistra)
+int64_t syscall_io_ring_setup(ioRing *ring);
+// Ejecuta hasta toSubmit operaciones encoladas; devuelve cuantas se completaron
+int64_t syscall_io_ring_enter(uint64_t toSubmit);
+
 // Pipes
 int syscall_open_pipe();
+// Igual que syscall_open_pipe, con la capacidad en bytes (se redondea a potencia de 2; 0 = 4 KB)
+// y flags (PIPE_SPSC si hay un único lector y un único escritor)
+int syscall_open_pipe_sized(uint64_t size, uint64_t flags);
+// Cambia la capacidad del pipe conservando los datos. Devuelve la nueva capacidad o -1
+int syscall_resize_pipe(int pipe_id, uint64_t size);
 int syscall_close_pipe(int pipe_id);
 int syscall_clear_pipe(int pipe_id);
 
@@ -7,7 +7,9 @@
 #define COL_PPID 5
 #define COL_WAIT 5
 #define COL_FG 4
+#define COL_MEM 10
 #define LINE_WIDTH 65
+#define COL_DETAIL 47 // ancho de las lineas de detalle debajo de cada proceso
 
 // ========== HELPER FUNCTIONS ==========
 
@@ -22,28 +24,77 @@ static int is_vowel(char c)
 			c == 'U');
 }
 
+#define RING_READ 0
+#define RING_ECHO 1
+#define RING_CHUNK 64 // caracteres pedidos en cada READ del anillo
+
 /**
  * @brief Reads and processes characters from stdin
+ * Reads up to RING_CHUNK characters at a time; the echo of each chunk and
+ * the next read go to the kernel in a single ring submission. Stops at
+ * EOF, or when a read or an echo fails.
  * @param process_char Function to process each character
  * @param context Additional context for processing
  * @return Number of characters processed
  */
 static int read_and_process_chars(int (*process_char)(char, void *), void *context)
 {
-	int c;
-	int count = 0;
+	ioRing *ring = malloc(sizeof(ioRing));
+	if (ring == NULL || io_ring_init(ring) != 0) {
+		free(ring);
+		printferror("Error al inicializar el anillo de syscalls\n");
+		return 0;
+	}
 
-	c = getChar();
-	while (c != EOF) {
-		if (c != 0) {
-			printf("%c", c);
-			if (process_char) {
-				process_char(c, context);
+	// el eco sale de un buffer mientras el siguiente READ llena el otro
+	char chunks[2][RING_CHUNK];
+	int current = 0;
+	int count = 0;
+	int done = 0;
+	ioCompletion cqe;
+
+	io_ring_prep(ring, IO_OP_READ, STDIN, chunks[current], RING_CHUNK, RING_READ);
+	while (io_ring_submit(ring) >= 0) {
+		// sin completion del READ (cola llena) cuenta como fallo
+		int64_t readResult = 0;
+		while (io_ring_reap(ring, &cqe)) {
+			if (cqe.userData == RING_READ) {
+				readResult = cqe.result;
+			} else if (cqe.result < 0) {
+				done = 1;
 			}
-			count++;
 		}
-		c = getChar();
+		if (done || readResult <= 0)
+			break;
+
+		char *chunk = chunks[current];
+		int echoed = 0;
+		for (int i = 0; i < readResult && !done; i++) {
+			if (chunk[i] == EOF) {
+				done = 1;
+			} else if (chunk[i] != 0) {
+				chunk[echoed++] = chunk[i];
+				if (process_char) {
+					process_char(chunk[i], context);
+				}
+				count++;
+			}
+		}
+		if (echoed > 0)
+			io_ring_prep(ring, IO_OP_WRITE, STDOUT, chunk, echoed, RING_ECHO);
+		if (done) {
+			if (echoed > 0 && io_ring_submit(ring) >= 0) {
+				while (io_ring_reap(ring, &cqe))
+					;
+			}
+			break;
+		}
+		current ^= 1;
+		io_ring_prep(ring, IO_OP_READ, STDIN, chunks[current], RING_CHUNK, RING_READ);
 	}
+
+	io_ring_exit(ring);
+	free(ring);
 	return count;
 }
 
@@ -60,43 +111,57 @@ static void printHex(unsigned int value)
 	printf("%s", hex);
 }
 
+/**
+ * @brief Imprime "<label><valor><unidad> " y devuelve la cantidad de caracteres
+ */
+static int printStat(const char *label, uint64_t value, const char *unit)
+{
+	char num[21];
+	uint64ToStr(value, num);
+	printf("%s%s%s ", label, num, unit);
+	return strlen(label) + strlen(num) + strlen(unit) + 1;
+}
+
+static void endDetailLine(int width)
+{
+	for (int i = width; i < COL_DETAIL; i++)
+		printf(" ");
+	printf("|\n");
+}
+
 void printHeader()
 {
 	printf("\nProcesos activos:\n");
-	printf("+-----+-------------+------+----------+----+\n");
-	printf("| PID | NAME        | PRIO | STATE    | FG |\n");
-	printf("+-----+-------------+------+----------+----+\n");
+	printf("+-----+-------------+------+----------+----+------------+\n");
+	printf("| PID | NAME        | PRIO | STATE    | FG | MEM        |\n");
+	printf("+-----+-------------+------+----------+----+------------+\n");
 }
 
-void printProcessInfo(PCB processInfo)
+static const char *stateToString(State state)
 {
-	const char *state;
-	switch (processInfo.state) {
+	switch (state) {
 	case READY:
-		state = "READY";
-		break;
+		return "READY";
 	case RUNNING:
-		state = "RUNNING";
-		break;
+		return "RUNNING";
 	case BLOCKED:
-		state = "BLOCKED";
-		break;
+		return "BLOCKED";
 	case ZOMBIE:
-		state = "ZOMBIE";
-		break;
+		return "ZOMBIE";
 	case EXITED:
-		state = "EXITED";
-		break;
+		return "EXITED";
 	case KILLED:
-		state = "KILLED";
-		break;
+		return "KILLED";
 	case SEM_WAITING:
-		state = "WAITING";
-		break;
+		return "WAITING";
 	default:
-		state = "UNKNOWN";
-		break;
+		return "UNKNOWN";
 	}
+}
+
+void printProcessInfo(PCB processInfo)
+{
+	const char *state = stateToString(processInfo.state);
 
 	printf("| ");
 	if (processInfo.pid < 10)
@@ -116,17 +181,37 @@ void printProcessInfo(PCB processInfo)
 		printf(" ");
 	printf(" | ");
 	printf("%s", processInfo.foreground ? "Y" : "N");
-	printf("  |\n");
+	printf("  | ");
+	char mem[21]; // hasta 20 digitos de un uint64 + terminador
+	uint64ToStr(processInfo.memoryUsed, mem);
+	printf("%s", mem);
+	for (int i = strlen(mem); i < COL_MEM; i++)
+		printf(" ");
+	printf(" |\n");
 	
 	printf("|     | RSP=0x");
 	printHex((unsigned int)processInfo.rsp);
-	printf("            |\n");
+	printf("                         |\n");
 
 	printf("|     | RBP=0x");
 	printHex((unsigned int)processInfo.base);
-	printf("            |\n");
+	printf("                         |\n");
+
+	// Contabilidad de CPU: t = ticks del timer
+	printf("|     | ");
+	int width = printStat("CPU=", processInfo.cpu.cpuTicks, "t");
+	width += printStat("CYC=", processInfo.cpu.cpuCycles, "");
+	width += printStat("LAST=", processInfo.cpu.lastRunTick, "t");
+	endDetailLine(width);
+
+	printf("|     | ");
+	width = printStat("VOL=", processInfo.cpu.voluntarySwitches, "");
+	width += printStat("INV=", processInfo.cpu.involuntarySwitches, "");
+	width += printStat("RDY=", processInfo.cpu.readyTicks, "t");
+	width += printStat("BLK=", processInfo.cpu.blockedTicks, "t");
+	endDetailLine(width);
 	
-	printf("+-----+-------------+------+----------+----+\n");
+	printf("+-----+-------------+------+----------+----+------------+\n");
 }
 
 uint64_t readLine(char *buff, uint64_t length)
@@ -264,7 +349,7 @@ uint64_t cat(uint64_t argc, char *argv[])
 
 void loop(uint64_t argc, char *argv[])
 {
-	pid_t pid = syscall_getpid();
+	pid_t pid = getpid();
 	int32_t time = satoi(argv[0]);
 
 	if (time <= 0) {
@@ -279,6 +364,191 @@ void loop(uint64_t argc, char *argv[])
 	}
 }
 
+// ========== TOP ==========
+
+#define TOP_MAX_TRACKED 64
+#define TOP_BATCH 4 // registros procStat pedidos por syscall
+#define COL_TOP_PID 5
+#define COL_TOP_NAME 13
+#define COL_TOP_PRIO 5
+#define COL_TOP_STATE 9
+#define COL_TOP_CPU 6
+#define COL_TOP_MEM 11
+
+/**
+ * @brief Contadores de un proceso en el refresco anterior de top
+ */
+typedef struct {
+	pid_t pid;
+	uint64_t cpuTicks;
+	uint64_t switches;
+} top_sample_t;
+
+static void printPadded(const char *str, int width)
+{
+	printf("%s", str);
+	for (int i = strlen(str); i < width; i++)
+		printf(" ");
+}
+
+static void printNumberPadded(uint64_t value, int width)
+{
+	char num[21];
+	uint64ToStr(value, num);
+	printPadded(num, width);
+}
+
+/**
+ * @brief Imprime una carga en punto fijo con dos decimales
+ */
+static void printLoad(uint64_t load)
+{
+	uint64_t frac = ((load & (LOAD_FIXED_1 - 1)) * 100) >> LOAD_FSHIFT;
+	printf("%l.%s%l", load >> LOAD_FSHIFT, frac < 10 ? "0" : "", frac);
+}
+
+static top_sample_t *findSample(top_sample_t *samples, uint64_t count, pid_t pid)
+{
+	for (uint64_t i = 0; i < count; i++) {
+		if (samples[i].pid == pid)
+			return &samples[i];
+	}
+	return NULL;
+}
+
+static void printTopRow(procStat *p, uint64_t cpuDelta, uint64_t switchDelta, uint64_t elapsed, uint64_t tickHz)
+{
+	printNumberPadded(p->pid, COL_TOP_PID);
+	printPadded(p->name, COL_TOP_NAME);
+	printNumberPadded(p->priority, COL_TOP_PRIO);
+	printPadded(stateToString(p->state), COL_TOP_STATE);
+	printNumberPadded(elapsed ? cpuDelta * 100 / elapsed : 0, COL_TOP_CPU);
+	printNumberPadded(p->memoryUsed, COL_TOP_MEM);
+	printf("%l\n", elapsed ? switchDelta * tickHz / elapsed : 0);
+}
+
+uint64_t top(uint64_t argc, char *argv[])
+{
+	int32_t interval = satoi(argv[0]);
+	if (interval <= 0) {
+		printferror("Error: el intervalo debe ser mayor que 0\n");
+		return 1;
+	}
+
+	// En el heap: el stack por defecto de un proceso es chico
+	top_sample_t *prev = malloc(2 * TOP_MAX_TRACKED * sizeof(top_sample_t));
+	if (prev == NULL) {
+		printferror("Error al asignar memoria para top\n");
+		return 1;
+	}
+	top_sample_t *next = prev + TOP_MAX_TRACKED;
+	uint64_t prevCount = 0;
+	uint64_t prevTicks = 0;
+
+	while (1) {
+		sysInfo sys;
+		memInfo mem;
+		if (syscall_sysInfo(&sys) == -1 || syscall_memInfo(&mem) == -1) {
+			printferror("Error al obtener las estadisticas del sistema\n");
+			free(prev);
+			return 1;
+		}
+
+		// El primer refresco muestra promedios desde el arranque
+		uint64_t elapsed = sys.ticks - prevTicks;
+
+		syscall_clearScreen();
+		printf("top - tick %l, %l ejecutables, %l cambios de contexto\n", sys.ticks, sys.runnable,
+		       sys.contextSwitches);
+		printf("Carga promedio (1, 5, 15 min): ");
+		printLoad(sys.loadAverage[0]);
+		printf(" ");
+		printLoad(sys.loadAverage[1]);
+		printf(" ");
+		printLoad(sys.loadAverage[2]);
+		printf("\nMemoria: total %l, usada %l, libre %l bytes\n\n", mem.total, mem.used, mem.free);
+
+		printPadded("PID", COL_TOP_PID);
+		printPadded("NAME", COL_TOP_NAME);
+		printPadded("PRIO", COL_TOP_PRIO);
+		printPadded("STATE", COL_TOP_STATE);
+		printPadded("CPU%", COL_TOP_CPU);
+		printPadded("MEM", COL_TOP_MEM);
+		printf("CSW/s\n");
+
+		procStat batch[TOP_BATCH];
+		uint64_t cursor = 0;
+		uint64_t nextCount = 0;
+		uint64_t filled;
+		while ((filled = syscall_procStat(&cursor, batch, TOP_BATCH)) > 0) {
+			for (uint64_t i = 0; i < filled; i++) {
+				procStat *p = &batch[i];
+				if (p->version != PROC_STAT_VERSION)
+					continue;
+				uint64_t switches = p->voluntarySwitches + p->involuntarySwitches;
+				uint64_t cpuDelta = p->cpuTicks;
+				uint64_t switchDelta = switches;
+				top_sample_t *sample = findSample(prev, prevCount, p->pid);
+				if (sample != NULL) {
+					cpuDelta -= sample->cpuTicks;
+					switchDelta -= sample->switches;
+				}
+				printTopRow(p, cpuDelta, switchDelta, elapsed, sys.tickHz);
+
+				if (nextCount < TOP_MAX_TRACKED) {
+					next[nextCount].pid = p->pid;
+					next[nextCount].cpuTicks = p->cpuTicks;
+					next[nextCount].switches = switches;
+					nextCount++;
+				}
+			}
+		}
+
+		for (uint64_t i = 0; i < nextCount; i++)
+			prev[i] = next[i];
+		prevCount = nextCount;
+		prevTicks = sys.ticks;
+
+		syscall_wait(interval);
+	}
+	free(prev);
+	return 0;
+}
+
+// ========== SYSSTAT ==========
+
+#define SYSSTAT_MAX 64
+#define COL_SYSSTAT_NAME 16
+#define COL_SYSSTAT_CALLS 12
+
+uint64_t sysstat(uint64_t argc, char *argv[])
+{
+	uint64_t *calls = malloc(2 * SYSSTAT_MAX * sizeof(uint64_t));
+	if (calls == NULL) {
+		printferror("Error al asignar memoria para sysstat\n");
+		return 1;
+	}
+	uint64_t *cycles = calls + SYSSTAT_MAX;
+
+	uint64_t count = syscall_syscallStats(calls, cycles, SYSSTAT_MAX);
+	if (count > SYSSTAT_MAX)
+		count = SYSSTAT_MAX;
+
+	printPadded("SYSCALL", COL_SYSSTAT_NAME);
+	printPadded("LLAMADAS", COL_SYSSTAT_CALLS);
+	printf("CICLOS/LLAMADA\n");
+	for (uint64_t i = 1; i < count; i++) {
+		if (calls[i] == 0)
+			continue;
+		printPadded(syscall_name(i), COL_SYSSTAT_NAME);
+		printNumberPadded(calls[i], COL_SYSSTAT_CALLS);
+		printf("%l\n", cycles[i] / calls[i]);
+	}
+
+	free(calls);
+	return 0;
+}
+
 // ========== STREAM PROCESSING PROGRAMS ==========
 
 /**
@@ -9,7 +9,7 @@
 #define MAX_ECHO 1000
 #define MAX_USERNAME_LENGTH 16
 #define PROMPT "%s@sh$ "
-#define CANT_INSTRUCTIONS 21
+#define CANT_INSTRUCTIONS 23
 uint64_t curr = 0;
 
 typedef enum {
@@ -29,6 +29,8 @@ typedef enum {
 	MVAR,
 	TEST_MALLOC_FREE,
 	NICE,
+	TOP,
+	SYSSTAT,
 	KILL,
 	BLOCK,
 	UNBLOCK,
@@ -131,13 +133,14 @@ static void handle_builtin_command(pipeCmd *pipe_cmd)
 
 static char *inst_list[] = {
 	"help", "echo", "clear",  "test_mm", "test_processes",   "test_prio", "test_sync", "ps",      "memInfo", "loop",
-	"wc",   "filter", "cat",     "mvar", "test_malloc_free", "nice", "kill",      "block",     "unblock",
+	"wc",   "filter", "cat",     "mvar", "test_malloc_free", "nice", "top", "sysstat", "kill",      "block",     "unblock",
 };
 
 static pid_t (*instruction_handlers[CANT_INSTRUCTIONS - 3])(char *, int, int) = {
     handle_help,      handle_echo,      handle_clear,  handle_test_mm,  handle_test_processes,
     handle_test_prio, handle_test_sync, handle_ps,     handle_mem_info, handle_loop,
-	handle_wc,        handle_filter, handle_cat,      handle_mvar,      handle_test_malloc_free, handle_nice
+	handle_wc,        handle_filter, handle_cat,      handle_mvar,      handle_test_malloc_free, handle_nice,
+	handle_top,       handle_sysstat
 };
 
 static void (*built_in_handlers[])(char *) = {
@@ -242,7 +245,8 @@ static void handle_piped_commands(pipeCmd *pipe_cmd)
 		return;
 	}
 
-	int pipe = syscall_open_pipe();
+	// un solo escritor (cmd1) y un solo lector (cmd2)
+	int pipe = syscall_open_pipe_sized(0, PIPE_SPSC);
 	if (pipe < 0) {
 		error_and_cleanup("Error al abrir el pipe\n", pipe_cmd);
 		return;
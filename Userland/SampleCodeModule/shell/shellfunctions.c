@@ -143,6 +143,8 @@ uint64_t doHelp(uint64_t argc, char **argv)
 	printf(" - memInfo: muestra estado de memoria\n");
 	printf(" - ps: muestra todos los procesos con su informacion\n");
 	printf(" - loop <tiempo>: imprime su PID cada tiempo especificado\n");
+	printf(" - top <ticks>: muestra CPU, memoria y cambios de contexto por proceso cada <ticks>\n");
+	printf(" - sysstat: muestra cuantas veces se llamo cada syscall y sus ciclos promedio\n");
 	printf(" - kill <pid>: mata el proceso con el PID especificado\n");
 	printf(" - nice <pid> <prioridad>: cambia la prioridad de un proceso (0-5)\n");
 	printf(" - block <pid>: bloquea el proceso con el PID especificado\n");
@@ -276,6 +278,16 @@ pid_t handle_loop(char *arg, int stdin, int stdout)
 	return handle_process_with_args("loop", (processFun)loop, arg, 1, "Uso: loop <time>\n", stdin, stdout, 0);
 }
 
+pid_t handle_top(char *arg, int stdin, int stdout)
+{
+	return handle_process_with_args("top", (processFun)top, arg, 1, "Uso: top <ticks>\n", stdin, stdout, 0);
+}
+
+pid_t handle_sysstat(char *arg, int stdin, int stdout)
+{
+	return handle_process_with_args("sysstat", (processFun)sysstat, arg, 0, "Uso: sysstat\n", stdin, stdout, 0);
+}
+
 pid_t handle_wc(char *arg, int stdin, int stdout)
 {
 	return handle_process_with_args("wc", (processFun)wc, arg, 0, "Uso: wc\n", stdin, stdout, 1);
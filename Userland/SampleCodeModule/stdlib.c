@@ -392,26 +392,282 @@ unsigned int randInt()
 	return (next / 65536) % 32768;
 }
 
-void *malloc(uint64_t size)
+static const volatile kernelData *const kernelPage = (const volatile kernelData *)KERNEL_DATA_ADDRESS;
+
+/*
+ * Heap de usuario: los pedidos de hasta 2^MAX_CLASS_LOG2 bytes se redondean
+ * a potencias de dos y se sirven desde listas libres por clase, tallando
+ * bloques de trozos que se piden al kernel con syscall_sbrk. Los pedidos
+ * más grandes van directo a syscall_allocMemory.
+ * Cada proceso tiene su propio heap: su estado vive al principio del primer
+ * trozo que pide, y el kernel publica esa dirección (heapBase) en la página
+ * de datos al despachar el proceso. No hace falta lock, así que matar un
+ * proceso en medio de malloc/free no deja nada tomado: solo el dueño toca
+ * sus listas libres, y los bloques que libera otro proceso entran con CAS
+ * a una lista remota que el dueño vacía en malloc.
+ * Cada bloque lleva una cabecera de 16 bytes (el payload queda alineado a
+ * 16) con una marca de uso, su clase y el heap dueño; los bloques libres se
+ * enlazan en el payload, sin pisar la cabecera.
+ */
+#define MIN_CLASS_LOG2 4
+#define MAX_CLASS_LOG2 11
+#define CLASS_COUNT (MAX_CLASS_LOG2 - MIN_CLASS_LOG2 + 1)
+#define LARGE_CLASS 0xFF
+#define HEAP_CHUNK_SIZE (64 * 1024)
+#define BLOCK_USED 0x55534544 /* "USED" */
+#define BLOCK_FREE 0x46524545 /* "FREE" */
+
+typedef struct processHeap processHeap;
+
+typedef struct blockHeader {
+	uint32_t magic; /* BLOCK_USED o BLOCK_FREE */
+	uint32_t sizeClass;
+	processHeap *heap; /* heap del que salió, NULL en bloques grandes */
+} blockHeader;
+
+typedef struct freeBlock {
+	struct freeBlock *next;
+} freeBlock;
+
+struct processHeap {
+	freeBlock *freeLists[CLASS_COUNT];
+	freeBlock *remoteFrees; /* liberados por otros procesos, se apilan con CAS */
+	uint8_t *current;       /* próximo byte sin usar del trozo actual */
+	uint8_t *end;
+};
+
+#define HEAP_STATE_SIZE ((sizeof(processHeap) + 15) & ~15UL)
+
+/*
+ * @brief Heap del proceso que corre; lo crea en su primer trozo si todavía no tiene
+ * @return el heap, o NULL si no hay memoria
+ */
+static processHeap *currentHeap()
 {
-    if (size == 0)
-        return NULL;
+	processHeap *heap = (processHeap *)kernelPage->heapBase;
+	if (heap != NULL) {
+		return heap;
+	}
+	uint8_t *chunk = syscall_sbrk(HEAP_CHUNK_SIZE);
+	if (chunk == NULL) {
+		return NULL;
+	}
+	heap = (processHeap *)chunk;
+	for (int i = 0; i < CLASS_COUNT; i++) {
+		heap->freeLists[i] = NULL;
+	}
+	heap->remoteFrees = NULL;
+	heap->current = chunk + HEAP_STATE_SIZE;
+	heap->end = chunk + HEAP_CHUNK_SIZE;
+	return heap;
+}
 
-    void *ptr = syscall_allocMemory(size);
+static uint64_t sizeToClass(uint64_t size)
+{
+	if (size <= (1UL << MIN_CLASS_LOG2)) {
+		return 0;
+	}
+	return (64 - __builtin_clzl(size - 1)) - MIN_CLASS_LOG2;
+}
 
-    if (ptr == NULL) {
-        char buf[32];
-        u64_to_str(size, buf);
-        printferror("Error allocating memory of size ");
-        printferror(buf);
-        printferror("\n");
-    }
+/*
+ * @brief Talla un bloque nuevo de la clase indicada, pidiendo otro trozo
+ * al kernel si el actual no alcanza
+ * @return puntero a la cabecera del bloque, o NULL si no hay memoria
+ */
+static blockHeader *carveBlock(processHeap *heap, uint64_t sizeClass)
+{
+	uint64_t blockSize = sizeof(blockHeader) + (1UL << (sizeClass + MIN_CLASS_LOG2));
+	if ((uint64_t)(heap->end - heap->current) < blockSize) {
+		uint8_t *chunk = syscall_sbrk(HEAP_CHUNK_SIZE);
+		if (chunk == NULL) {
+			return NULL;
+		}
+		/* si el trozo nuevo es contiguo se extiende el actual */
+		if (chunk != heap->end) {
+			heap->current = chunk;
+		}
+		heap->end = chunk + HEAP_CHUNK_SIZE;
+	}
+	blockHeader *block = (blockHeader *)heap->current;
+	heap->current += blockSize;
+	block->heap = heap;
+	return block;
+}
 
-    return ptr;
+/*
+ * @brief Pasa a las listas libres del heap los bloques que le devolvieron
+ * otros procesos. Solo la llama el dueño del heap
+ */
+static void reclaimRemoteFrees(processHeap *heap)
+{
+	freeBlock *node = __atomic_exchange_n(&heap->remoteFrees, NULL, __ATOMIC_ACQUIRE);
+	while (node != NULL) {
+		freeBlock *next = node->next;
+		uint32_t sizeClass = ((blockHeader *)node - 1)->sizeClass;
+		node->next = heap->freeLists[sizeClass];
+		heap->freeLists[sizeClass] = node;
+		node = next;
+	}
 }
+
+/*
+ * @brief Devuelve un bloque al heap de otro proceso sin tocar sus listas
+ * libres: lo apila en la lista remota, que es lo único que se comparte
+ */
+static void pushRemoteFree(processHeap *heap, freeBlock *node)
+{
+	freeBlock *head = __atomic_load_n(&heap->remoteFrees, __ATOMIC_RELAXED);
+	do {
+		node->next = head;
+	} while (!__atomic_compare_exchange_n(&heap->remoteFrees, &head, node, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+void *malloc(uint64_t size)
+{
+	if (size == 0)
+		return NULL;
+
+	blockHeader *block = NULL;
+	if (size > (1UL << MAX_CLASS_LOG2)) {
+		block = syscall_allocMemory(sizeof(blockHeader) + size);
+		if (block != NULL) {
+			block->sizeClass = LARGE_CLASS;
+			block->heap = NULL;
+		}
+	} else {
+		uint64_t sizeClass = sizeToClass(size);
+		processHeap *heap = currentHeap();
+		if (heap != NULL) {
+			if (heap->freeLists[sizeClass] == NULL && heap->remoteFrees != NULL) {
+				reclaimRemoteFrees(heap);
+			}
+			freeBlock *node = heap->freeLists[sizeClass];
+			if (node != NULL) {
+				heap->freeLists[sizeClass] = node->next;
+				block = (blockHeader *)node - 1;
+			} else {
+				block = carveBlock(heap, sizeClass);
+			}
+		}
+		if (block != NULL) {
+			block->sizeClass = sizeClass;
+		}
+	}
+
+	if (block == NULL) {
+		char buf[32];
+		u64_to_str(size, buf);
+		printferror("Error allocating memory of size ");
+		printferror(buf);
+		printferror("\n");
+		return NULL;
+	}
+
+	block->magic = BLOCK_USED;
+	return block + 1;
+}
+
 void free(void *ptr)
 {
 	if (ptr == NULL)
 		return;
-	syscall_freeMemory(ptr);
-}
\ No newline at end of file
+	blockHeader *block = (blockHeader *)ptr - 1;
+	/* doble free o puntero que no salió de malloc */
+	if (block->magic != BLOCK_USED || (block->sizeClass >= CLASS_COUNT && block->sizeClass != LARGE_CLASS))
+		return;
+	/* si dos procesos liberan el mismo bloque a la vez, solo uno gana el CAS */
+	uint32_t used = BLOCK_USED;
+	if (!__atomic_compare_exchange_n(&block->magic, &used, BLOCK_FREE, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+		return;
+	if (block->sizeClass == LARGE_CLASS) {
+		syscall_freeMemory(block);
+		return;
+	}
+
+	freeBlock *node = (freeBlock *)(block + 1);
+	if (block->heap != (processHeap *)kernelPage->heapBase) {
+		pushRemoteFree(block->heap, node);
+		return;
+	}
+	node->next = block->heap->freeLists[block->sizeClass];
+	block->heap->freeLists[block->sizeClass] = node;
+}
+
+// ========== ANILLO DE SYSCALLS ==========
+
+int io_ring_init(ioRing *ring)
+{
+	ring->sqHead = ring->sqTail = 0;
+	ring->cqHead = ring->cqTail = 0;
+	return syscall_io_ring_setup(ring) == 0 ? 0 : -1;
+}
+
+void io_ring_exit(ioRing *ring)
+{
+	syscall_io_ring_setup(NULL);
+}
+
+int io_ring_prep(ioRing *ring, ioOp op, int fd, void *addr, uint64_t len, uint64_t userData)
+{
+	if (ring->sqTail - ring->sqHead >= IO_RING_ENTRIES)
+		return -1;
+	ioSubmission *sqe = &ring->sq[ring->sqTail & IO_RING_MASK];
+	sqe->op = op;
+	sqe->fd = fd;
+	sqe->addr = (uint64_t)addr;
+	sqe->len = len;
+	sqe->userData = userData;
+	ring->sqTail++;
+	return 0;
+}
+
+int64_t io_ring_submit(ioRing *ring)
+{
+	uint32_t pending = ring->sqTail - ring->sqHead;
+	if (pending == 0)
+		return 0;
+	return syscall_io_ring_enter(pending);
+}
+
+int io_ring_reap(ioRing *ring, ioCompletion *cqe)
+{
+	if (ring->cqHead == ring->cqTail)
+		return 0;
+	*cqe = ring->cq[ring->cqHead & IO_RING_MASK];
+	ring->cqHead++;
+	return 1;
+}
+
+// ========== PAGINA DE DATOS DEL KERNEL ==========
+
+pid_t getpid()
+{
+	return kernelPage->pid;
+}
+
+uint64_t getTicks()
+{
+	return kernelPage->ticks;
+}
+
+uint64_t getCyclesPerTick()
+{
+	return kernelPage->tscPerTick;
+}
+
+void getWallClock(wallClock *clock)
+{
+	uint32_t sequence;
+	do {
+		// impar: el kernel está escribiendo la página
+		while ((sequence = kernelPage->sequence) & 1)
+			;
+		clock->sec = kernelPage->clock.sec;
+		clock->min = kernelPage->clock.min;
+		clock->hour = kernelPage->clock.hour;
+		clock->day = kernelPage->clock.day;
+		clock->month = kernelPage->clock.month;
+		clock->year = kernelPage->clock.year;
+	} while (sequence != kernelPage->sequence);
+}
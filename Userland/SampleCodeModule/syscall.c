@@ -4,12 +4,13 @@
 #include <syscall.h>
 
 /*
- * @brief Realiza una interrupción 0x80 (SYSCALL)
+ * @brief Realiza una syscall (instrucción SYSCALL)
  * @param code código de syscall
  * @param param... lo que corresponda para cada uno de los parámetros de la syscall. 0 si no se usa.
  * @return lo que devuelva la syscall
  */
-extern int64_t syscall(uint64_t code, uint64_t param1, uint64_t param2, uint64_t param3);
+extern int64_t syscall(uint64_t code, uint64_t param1, uint64_t param2, uint64_t param3, uint64_t param4,
+                       uint64_t param5, uint64_t param6);
 
 enum syscall_number {
 	NONE,
@@ -42,162 +43,228 @@ enum syscall_number {
 	CLEAR_PIPE,
 	WAITPID,
 	WRITE_COLOR,
-	WAIT_SECONDS
+	WAIT_SECONDS,
+	SBRK,
+	SYS_INFO,
+	PROC_STAT,
+	SYSCALL_STATS,
+	IO_RING_SETUP,
+	IO_RING_ENTER,
+	RESIZE_PIPE,
+	CANT_SYSCALLS
 };
 
+static const char *syscall_names[CANT_SYSCALLS] = {
+    "none",        "read",       "write",        "clear_screen", "size_up_font",
+    "size_down_font", "get_height", "get_width", "wait",         "alloc",
+    "free",        "create_proc", "getpid",      "kill",         "block",
+    "unblock",     "change_prio", "process_info", "mem_info",    "exit",
+    "sem_open",    "sem_wait",   "sem_post",     "sem_close",    "yield",
+    "open_pipe",   "close_pipe", "clear_pipe",   "waitpid",      "write_color",
+    "wait_seconds", "sbrk",      "sys_info",     "proc_stat",    "syscall_stats",
+    "io_ring_setup", "io_ring_enter", "resize_pipe",
+};
+
+const char *syscall_name(uint64_t number)
+{
+	return number < CANT_SYSCALLS ? syscall_names[number] : "unknown";
+}
+
 uint64_t syscall_read(uint64_t fd, char *buff, uint64_t len)
 {
-	return syscall(READ, fd, (uint64_t)buff, len);
+	return syscall(READ, fd, (uint64_t)buff, len, 0, 0, 0);
 }
 
 uint64_t syscall_write(uint64_t fd, char *buff, uint64_t len)
 {
-	return syscall(WRITE, fd, (uint64_t)buff, len);
+	return syscall(WRITE, fd, (uint64_t)buff, len, 0, 0, 0);
 }
 
 uint64_t syscall_write_color(char *buff, uint64_t len, uint32_t color)
 {
-	return syscall(WRITE_COLOR, (uint64_t)buff, len, (uint64_t)color);
+	return syscall(WRITE_COLOR, (uint64_t)buff, len, (uint64_t)color, 0, 0, 0);
 }
 
 uint64_t syscall_clearScreen()
 {
-	return syscall(CLEAR_SCREEN, 0, 0, 0);
+	return syscall(CLEAR_SCREEN, 0, 0, 0, 0, 0, 0);
 }
 
 uint64_t syscall_sizeUpFont(uint64_t increment)
 {
-	return syscall(SIZE_UP_FONT, increment, 0, 0);
+	return syscall(SIZE_UP_FONT, increment, 0, 0, 0, 0, 0);
 }
 
 uint64_t syscall_sizeDownFont(uint64_t decrement)
 {
-	return syscall(SIZE_DOWN_FONT, decrement, 0, 0);
+	return syscall(SIZE_DOWN_FONT, decrement, 0, 0, 0, 0, 0);
 }
 
 uint64_t syscall_getHeight()
 {
-	return syscall(GET_HEIGHT, 0, 0, 0);
+	return syscall(GET_HEIGHT, 0, 0, 0, 0, 0, 0);
 }
 
 uint64_t syscall_getWidth()
 {
-	return syscall(GET_WIDTH, 0, 0, 0);
+	return syscall(GET_WIDTH, 0, 0, 0, 0, 0, 0);
 }
 
 uint64_t syscall_wait(uint64_t ticks)
 {
-	return syscall(WAIT, ticks, 0, 0);
+	return syscall(WAIT, ticks, 0, 0, 0, 0, 0);
 }
 
 void *syscall_allocMemory(uint64_t size)
 {
-	return (void *)syscall(ALLOC_MEMORY, size, 0, 0);
+	return (void *)syscall(ALLOC_MEMORY, size, 0, 0, 0, 0, 0);
 }
 
 int syscall_freeMemory(void *address)
 {
-	return syscall(FREE_MEMORY, (uint64_t)address, 0, 0);
+	return syscall(FREE_MEMORY, (uint64_t)address, 0, 0, 0, 0, 0);
+}
+
+void *syscall_sbrk(uint64_t increment)
+{
+	return (void *)syscall(SBRK, increment, 0, 0, 0, 0, 0);
+}
+
+int64_t syscall_sysInfo(sysInfo *info)
+{
+	return syscall(SYS_INFO, (uint64_t)info, 0, 0, 0, 0, 0);
+}
+
+uint64_t syscall_syscallStats(uint64_t *calls, uint64_t *cycles, uint64_t capacity)
+{
+	return syscall(SYSCALL_STATS, (uint64_t)calls, (uint64_t)cycles, capacity, 0, 0, 0);
+}
+
+int64_t syscall_io_ring_setup(ioRing *ring)
+{
+	return syscall(IO_RING_SETUP, (uint64_t)ring, 0, 0, 0, 0, 0);
+}
+
+int64_t syscall_io_ring_enter(uint64_t toSubmit)
+{
+	return syscall(IO_RING_ENTER, toSubmit, 0, 0, 0, 0, 0);
+}
+
+uint64_t syscall_procStat(uint64_t *cursor, procStat *buffer, uint64_t capacity)
+{
+	return syscall(PROC_STAT, (uint64_t)cursor, (uint64_t)buffer, capacity, 0, 0, 0);
 }
 
 uint64_t syscall_create_process(char *name, processFun function, char *argv[], uint8_t priority, char foreground,
                                 int stdin, int stdout)
 {
-	ProcessParams params = {.name = name,
-	                        .function = function,
-	                        .arg = argv,
-	                        .priority = priority,
-	                        .foreground = foreground,
-	                        .stdin = stdin,
-	                        .stdout = stdout};
-	return syscall(CREATE_PROCESS, (uint64_t)&params, 0, 0);
+	return syscall_create_process_with_stack(name, function, argv, priority, foreground, stdin, stdout, 0);
+}
+
+uint64_t syscall_create_process_with_stack(char *name, processFun function, char *argv[], uint8_t priority,
+                                           char foreground, int stdin, int stdout, uint64_t stackSize)
+{
+	// prioridad y foreground viajan en un registro, stdin y stdout en otro
+	uint64_t flags = priority | ((uint64_t)(foreground ? 1 : 0) << 8);
+	uint64_t fds = (uint32_t)stdin | ((uint64_t)(uint32_t)stdout << 32);
+	return syscall(CREATE_PROCESS, (uint64_t)name, (uint64_t)function, (uint64_t)argv, flags, fds, stackSize);
 }
 
 uint64_t syscall_getpid()
 {
-	return syscall(GETPID, 0, 0, 0);
+	return syscall(GETPID, 0, 0, 0, 0, 0, 0);
 }
 
 uint64_t syscall_kill(uint64_t pid)
 {
-	return syscall(KILL, pid, 0, 0);
+	return syscall(KILL, pid, 0, 0, 0, 0, 0);
 }
 
 uint64_t syscall_block(uint64_t pid)
 {
-	return syscall(BLOCK, pid, 0, 0);
+	return syscall(BLOCK, pid, 0, 0, 0, 0, 0);
 }
 
 uint64_t syscall_unblock(uint64_t pid)
 {
-	return syscall(UNBLOCK, pid, 0, 0);
+	return syscall(UNBLOCK, pid, 0, 0, 0, 0, 0);
 }
 
 int8_t syscall_changePrio(uint64_t pid, int8_t newPrio)
 {
-	return syscall(CHANGE_PRIO, pid, newPrio, 0);
+	return syscall(CHANGE_PRIO, pid, newPrio, 0, 0, 0, 0);
 }
 
 PCB *syscall_getProcessInfo(uint64_t *cantProcesses)
 {
-	return (PCB *)syscall(GET_PROCESS_INFO, (uint64_t)cantProcesses, 0, 0);
+	return (PCB *)syscall(GET_PROCESS_INFO, (uint64_t)cantProcesses, 0, 0, 0, 0, 0);
 }
 
 int64_t syscall_memInfo(memInfo *info)
 {
-	return syscall(MEM_INFO, (uint64_t)info, 0, 0);
+	return syscall(MEM_INFO, (uint64_t)info, 0, 0, 0, 0, 0);
 }
 
 int syscall_exit()
 {
-	return syscall(EXIT, 0, 0, 0);
+	return syscall(EXIT, 0, 0, 0, 0, 0, 0);
 }
 
 int syscall_sem_open(int sem_id, uint64_t initialValue)
 {
-	return syscall(SEM_OPEN, sem_id, initialValue, 0);
+	return syscall(SEM_OPEN, sem_id, initialValue, 0, 0, 0, 0);
 }
 
 int syscall_sem_wait(int sem_id)
 {
-	return syscall(SEM_WAIT, sem_id, 0, 0);
+	return syscall(SEM_WAIT, sem_id, 0, 0, 0, 0, 0);
 }
 
 int syscall_sem_post(int sem_id)
 {
-	return syscall(SEM_POST, sem_id, 0, 0);
+	return syscall(SEM_POST, sem_id, 0, 0, 0, 0, 0);
 }
 
 int syscall_sem_close(int sem_id)
 {
-	return syscall(SEM_CLOSE, sem_id, 0, 0);
+	return syscall(SEM_CLOSE, sem_id, 0, 0, 0, 0, 0);
 }
 
 int syscall_yield()
 {
-	return syscall(YIELD, 0, 0, 0);
+	return syscall(YIELD, 0, 0, 0, 0, 0, 0);
 }
 
 int syscall_open_pipe()
 {
-	return syscall(OPEN_PIPE, 0, 0, 0);
+	return syscall(OPEN_PIPE, 0, 0, 0, 0, 0, 0);
+}
+
+int syscall_open_pipe_sized(uint64_t size, uint64_t flags)
+{
+	return syscall(OPEN_PIPE, size, flags, 0, 0, 0, 0);
+}
+
+int syscall_resize_pipe(int pipe_id, uint64_t size)
+{
+	return syscall(RESIZE_PIPE, pipe_id, size, 0, 0, 0, 0);
 }
 
 int syscall_close_pipe(int pipe_id)
 {
-	return syscall(CLOSE_PIPE, pipe_id, 0, 0);
+	return syscall(CLOSE_PIPE, pipe_id, 0, 0, 0, 0, 0);
 }
 
 int syscall_clear_pipe(int pipe_id)
 {
-	return syscall(CLEAR_PIPE, pipe_id, 0, 0);
+	return syscall(CLEAR_PIPE, pipe_id, 0, 0, 0, 0, 0);
 }
 
 pid_t syscall_waitpid(pid_t pid, int32_t *status)
 {
-	return syscall(WAITPID, pid, (uint64_t)status, 0);
+	return syscall(WAITPID, pid, (uint64_t)status, 0, 0, 0, 0);
 }
 
 uint64_t syscall_wait_seconds(uint64_t seconds) {
-    return syscall(WAIT_SECONDS, seconds, 0, 0);
+    return syscall(WAIT_SECONDS, seconds, 0, 0, 0, 0, 0);
 }
@@ -6,9 +6,10 @@
 
 #define TOTAL_PROCESSES 3
 
-#define LOWEST 0
+// 0 es la prioridad más urgente
+#define LOWEST 2
 #define MEDIUM 1
-#define HIGHEST 2
+#define HIGHEST 0
 
 int64_t prio[TOTAL_PROCESSES] = {LOWEST, MEDIUM, HIGHEST};
 
@@ -21,7 +22,7 @@ void zero_to_max()
 	while (value++ != max_value)
 		;
 
-	printf("PROCESS %d DONE!\n", syscall_getpid());
+	printf("PROCESS %d DONE!\n", getpid());
 }
 
 uint64_t test_prio(uint64_t argc, char *argv[])
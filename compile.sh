@@ -2,8 +2,9 @@
 
 NOMBRE="tp_so_g15"
 
-# Select memory manager: -buddy (default) or -bitmap
+# Select memory manager: -buddy (default), -bitmap, -bitmap-bestfit or -tlsf
 MM_FLAG=""
+FIT_FLAG="FIRST_FIT"
 case "$1" in
 	"-buddy")
 		MM_FLAG="BUDDY"
@@ -11,6 +12,13 @@ case "$1" in
 	"-bitmap")
 		MM_FLAG="BITMAP"
 		;;
+	"-bitmap-bestfit")
+		MM_FLAG="BITMAP"
+		FIT_FLAG="BEST_FIT"
+		;;
+	"-tlsf")
+		MM_FLAG="TLSF"
+		;;
 	*)
 		MM_FLAG="BUDDY"
 		;;
@@ -20,5 +28,5 @@ sudo docker start $NOMBRE
 sudo docker exec -it $NOMBRE bash -c "make clean -C /root/Toolchain"
 sudo docker exec -it $NOMBRE bash -c "make clean -C /root/"
 sudo docker exec -it $NOMBRE bash -c "make MM=$MM_FLAG -C /root/Toolchain"
-sudo docker exec -it $NOMBRE bash -c "make MM=$MM_FLAG -C /root/"
+sudo docker exec -it $NOMBRE bash -c "make MM=$MM_FLAG FIT=$FIT_FLAG -C /root/"
 #docker stop $NOMBRE
\ No newline at end of file